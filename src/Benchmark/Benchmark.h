@@ -0,0 +1,142 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#pragma once
+
+#include "defines.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Ajiva::Benchmark
+{
+    // counted by the replaced global operator new in main.cpp
+    u64 AllocationCount();
+
+    struct Options
+    {
+        std::vector<u64> Workers; // empty: 1, 2, 4, ... up to hardware_concurrency
+        u64 Tasks = 200000;
+        u64 Rounds = 200; // fan-out/fan-in repetitions
+        u64 Events = 1000000; // dispatches per event benchmark
+        bool Legacy = true;
+        bool Current = true;
+    };
+
+    class Stopwatch
+    {
+    public:
+        Stopwatch() : start(std::chrono::steady_clock::now())
+        {
+        }
+
+        [[nodiscard]] f64 ElapsedMs() const
+        {
+            return std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+
+    private:
+        std::chrono::steady_clock::time_point start;
+    };
+
+    // 0 instead of nan or inf when nothing was measured, e.g. --tasks below the suite size or a run under 1 ms
+    inline f64 Ratio(f64 value, f64 per)
+    {
+        return per > 0 ? value / per : 0;
+    }
+
+    // sorts in place, p in [0, 1]
+    inline f64 Percentile(std::vector<f64>& samples, f64 p)
+    {
+        if (samples.empty()) return 0;
+        std::sort(samples.begin(), samples.end());
+        const auto index = static_cast<u64>(p * static_cast<f64>(samples.size() - 1) + 0.5);
+        return samples[std::min<u64>(index, samples.size() - 1)];
+    }
+
+    // Minimal streaming JSON writer, no escaping beyond quotes and backslashes (keys and names are ours).
+    class JsonWriter
+    {
+    public:
+        explicit JsonWriter(std::ostream& out) : out(out)
+        {
+        }
+
+        void BeginObject(const char* key = nullptr)
+        {
+            Prefix(key);
+            out << '{';
+            first = true;
+        }
+
+        void EndObject()
+        {
+            out << '}';
+            first = false;
+        }
+
+        void BeginArray(const char* key = nullptr)
+        {
+            Prefix(key);
+            out << '[';
+            first = true;
+        }
+
+        void EndArray()
+        {
+            out << ']';
+            first = false;
+        }
+
+        // json has no nan or inf
+        void Value(const char* key, f64 value)
+        {
+            Prefix(key);
+            if (std::isfinite(value))
+                out << value;
+            else
+                out << "null";
+        }
+
+        void Value(const char* key, u64 value)
+        {
+            Prefix(key);
+            out << value;
+        }
+
+        void Value(const char* key, const std::string& value)
+        {
+            Prefix(key);
+            out << '"';
+            for (char c : value)
+            {
+                if (c == '"' || c == '\\') out << '\\';
+                out << c;
+            }
+            out << '"';
+        }
+
+    private:
+        std::ostream& out;
+        bool first = true;
+
+        void Prefix(const char* key)
+        {
+            if (!first) out << ',';
+            first = false;
+            if (key) out << '"' << key << "\":";
+        }
+    };
+
+    // false if the current pool allocated per task after its warm-up
+    bool RunThreadPoolBenchmarks(const Options& options, JsonWriter& json);
+
+    void RunEventBenchmarks(const Options& options, JsonWriter& json);
+} // Ajiva
+// Benchmark
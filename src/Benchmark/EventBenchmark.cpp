@@ -0,0 +1,142 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#include "Benchmark.h"
+#include "LegacyEventSystem.h"
+#include "Core/EventSystem.h"
+#include "Core/EventChannel.h"
+
+#include <iostream>
+
+namespace Ajiva::Benchmark
+{
+    struct MoveListener
+    {
+        i64 sum = 0;
+
+        void OnMove(AJ_EVENT_PARAMETERS)
+        {
+            sum += event.mouse.move.dx;
+        }
+
+        void OnMoved(const Core::EventContext& event)
+        {
+            sum += event.mouse.move.dx;
+        }
+    };
+
+    // same loop shape for the typed channel, the payload type does not matter for the dispatch cost
+    struct ChannelAdapter
+    {
+        Core::EventChannel<Core::EventContext> channel;
+
+        void FireEvent(Core::EventCode, void*, const Core::EventContext& context)
+        {
+            channel.Publish(context);
+        }
+    };
+
+    struct EventResult
+    {
+        f64 NsPerEvent = 0;
+        f64 AllocationsPerEvent = 0;
+        f64 SubscribeUnsubscribeNs = 0;
+    };
+
+    template <typename System, typename Subscribe>
+    static EventResult MouseMoveDispatch(System& system, std::vector<MoveListener>& listeners, u64 events,
+                                         const Subscribe& subscribe)
+    {
+        EventResult result;
+        {
+            Stopwatch watch;
+            for (u64 round = 0; round < 100; ++round)
+            {
+                auto subscriptions = subscribe();
+            }
+            result.SubscribeUnsubscribeNs = Ratio(watch.ElapsedMs() * 1e6 / 100.0, static_cast<f64>(listeners.size()));
+        }
+
+        auto subscriptions = subscribe();
+        Core::EventContext context{};
+        context.mouse.move.dx = 1;
+        const u64 allocations = AllocationCount();
+        Stopwatch watch;
+        for (u64 i = 0; i < events; ++i)
+        {
+            system.FireEvent(Core::MouseMove, nullptr, context);
+        }
+        result.NsPerEvent = Ratio(watch.ElapsedMs() * 1e6, static_cast<f64>(events));
+        result.AllocationsPerEvent = Ratio(static_cast<f64>(AllocationCount() - allocations), static_cast<f64>(events));
+        return result;
+    }
+
+    static void Write(JsonWriter& json, const char* name, u64 listeners, const EventResult& result)
+    {
+        json.BeginObject();
+        json.Value("system", std::string(name));
+        json.Value("listeners", listeners);
+        json.Value("ns_per_event", result.NsPerEvent);
+        json.Value("allocations_per_event", result.AllocationsPerEvent);
+        json.Value("subscribe_unsubscribe_ns", result.SubscribeUnsubscribeNs);
+        json.EndObject();
+    }
+
+    void RunEventBenchmarks(const Options& options, JsonWriter& json)
+    {
+        json.BeginObject("events");
+        json.Value("legacy_size_bytes", static_cast<u64>(sizeof(LegacyEventSystem)));
+        json.Value("current_size_bytes", static_cast<u64>(sizeof(Core::EventSystem)));
+        json.BeginArray("mouse_move");
+        for (u64 count : {1, 4, 16, 64})
+        {
+            std::cerr << "events, " << count << " listeners" << std::endl;
+            std::vector<MoveListener> listeners(count);
+            if (options.Legacy)
+            {
+                auto system = CreateScope<LegacyEventSystem>();
+                auto result = MouseMoveDispatch(*system, listeners, options.Events, [&]()
+                {
+                    std::vector<Ref<LegacyEventSystem::IListener>> subscriptions;
+                    for (auto& listener : listeners)
+                    {
+                        subscriptions.push_back(system->Add<MoveListener, void>(Core::MouseMove, &listener,
+                                                                                &MoveListener::OnMove));
+                    }
+                    return subscriptions;
+                });
+                Write(json, "legacy", count, result);
+            }
+            if (options.Current)
+            {
+                Core::EventSystem system;
+                auto result = MouseMoveDispatch(system, listeners, options.Events, [&]()
+                {
+                    std::vector<Core::EventSubscription> subscriptions;
+                    for (auto& listener : listeners)
+                    {
+                        subscriptions.push_back(system.Add(Core::MouseMove, &listener, &MoveListener::OnMove));
+                    }
+                    return subscriptions;
+                });
+                Write(json, "current", count, result);
+
+                ChannelAdapter adapter;
+                auto channelResult = MouseMoveDispatch(adapter, listeners, options.Events, [&]()
+                {
+                    std::vector<Core::EventChannel<Core::EventContext>::Subscription> subscriptions;
+                    for (auto& listener : listeners)
+                    {
+                        subscriptions.push_back(adapter.channel.Subscribe<&MoveListener::OnMoved>(&listener));
+                    }
+                    return subscriptions;
+                });
+                Write(json, "channel", count, channelResult);
+            }
+        }
+        json.EndArray();
+        json.EndObject();
+    }
+} // Ajiva
+// Benchmark
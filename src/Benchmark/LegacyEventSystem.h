@@ -0,0 +1,113 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#pragma once
+
+#include "defines.h"
+#include "Core/EventSystem.h"
+
+#include <memory>
+#include <vector>
+
+namespace Ajiva::Benchmark
+{
+    // The weak_ptr based event system the engine used before the dense dispatch table, kept as the A/B baseline.
+    // Unchanged apart from living in one header.
+    class LegacyEventSystem
+    {
+    public:
+        class IListener
+        {
+        public:
+            virtual ~IListener() = default;
+
+            virtual bool operator()(AJ_EVENT_PARAMETERS) = 0;
+        };
+
+        template <typename D, typename R>
+        class Listener : public IListener
+        {
+        public:
+            typedef R (D::*Callback)(AJ_EVENT_PARAMETERS);
+
+            Listener(D* instance, Callback callback) : instance(instance), callback(callback)
+            {
+            }
+
+            bool operator()(AJ_EVENT_PARAMETERS) override
+            {
+                if constexpr (std::is_same_v<R, bool>)
+                {
+                    return (instance->*callback)(AJ_EVENT_PARAMETERS_CALL);
+                }
+                else
+                {
+                    (instance->*callback)(AJ_EVENT_PARAMETERS_CALL);
+                    return false;
+                }
+            }
+
+        private:
+            D* instance;
+            Callback callback;
+        };
+
+        template <typename D, typename R>
+        Ref<Listener<D, R>> Add(Core::EventCode eventCode, D* instance, typename Listener<D, R>::Callback callback)
+        {
+            std::shared_ptr<Listener<D, R>> listener(new Listener<D, R>(instance, callback),
+                                                     [this, eventCode](Listener<D, R>* pi)
+                                                     {
+                                                         this->Remove(eventCode, pi);
+                                                         delete pi;
+                                                     });
+            registered[eventCode].push_back(listener);
+            return listener;
+        }
+
+        bool FireEvent(Core::EventCode eventCode, void* sender, const Core::EventContext& context)
+        {
+            bool handled = false;
+            try
+            {
+                for (auto it = registered[eventCode].begin(); it != registered[eventCode].end();)
+                {
+                    if (it->expired())
+                    {
+                        it = registered[eventCode].erase(it);
+                        continue;
+                    }
+                    if ((*it->lock())(eventCode, sender, context))
+                    {
+                        return true;
+                    }
+                    handled = true;
+                    ++it;
+                }
+            }
+            catch (std::exception&)
+            {
+                return false;
+            }
+            return handled;
+        }
+
+    private:
+        std::vector<std::weak_ptr<IListener>> registered[MAX_MESSAGE_CODES];
+
+        bool Remove(Core::EventCode eventCode, IListener* listener)
+        {
+            for (auto it = registered[eventCode].begin(); it != registered[eventCode].end(); ++it)
+            {
+                if (it->expired() || it->lock().get() == listener)
+                {
+                    registered[eventCode].erase(it);
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+} // Ajiva
+// Benchmark
@@ -0,0 +1,137 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#pragma once
+
+#include "defines.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Ajiva::Benchmark
+{
+    // The mutex + condition variable pool the engine used before the work stealing scheduler, kept as the A/B
+    // baseline. Differences to the original: sizes are runtime values (it was ThreadPool<N, T>), the ring index
+    // wraps and IsFull compares the right way round, and workers wake blocked producers. Without those fixes it
+    // could not survive a full queue, the locking and wake up behaviour is unchanged.
+    class LegacyThreadPool
+    {
+        struct Worker
+        {
+            LegacyThreadPool* pool;
+            std::thread thread;
+            u64 index = 0;
+            bool working = false;
+        };
+
+        struct Work
+        {
+            std::function<void()> func;
+            std::function<void()> callback;
+        };
+
+    public:
+        LegacyThreadPool(u64 workerCount, u64 capacity) : states(workerCount), works(capacity)
+        {
+            for (u64 i = 0; i < workerCount; ++i)
+            {
+                auto state = &states[i];
+                state->pool = this;
+                state->index = i;
+                state->thread = std::thread([state]()
+                {
+                    state->pool->WorkerLoop(state);
+                });
+            }
+        }
+
+        ~LegacyThreadPool()
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                shutdown = true;
+            }
+            cv.notify_all();
+            for (auto& state : states)
+            {
+                if (state.thread.joinable())
+                {
+                    state.thread.join();
+                }
+            }
+        }
+
+        void QueueWork(const std::function<void()>& func, const std::function<void()>& callback = nullptr)
+        {
+            if (shutdown) return;
+            std::unique_lock<std::mutex> lock(mutex);
+            if (shutdown) return;
+            while (IsFull())
+            {
+                cv.wait(lock, [this]() { return !IsFull() || shutdown; });
+            }
+            auto i = this->head++ % works.size();
+            works[i].func = func;
+            works[i].callback = callback;
+            PLOG_DEBUG << "QueueWork: " << i << " " << head << " " << tail;
+            cv.notify_one();
+        }
+
+        bool IsWorking()
+        {
+            return tail < head;
+        }
+
+        bool IsFull()
+        {
+            return head - tail >= works.size();
+        }
+
+        bool IsEmpty()
+        {
+            return tail == head;
+        }
+
+    private:
+        std::vector<Worker> states;
+        std::vector<Work> works;
+
+        std::atomic<u64> head{0}; // last added index
+        std::atomic<u64> tail{0}; // next to be processed index
+
+        bool shutdown = false;
+
+        std::mutex mutex;
+        std::condition_variable cv;
+
+        void WorkerLoop(Worker* state)
+        {
+            while (!shutdown)
+            {
+                Work work;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cv.wait(lock, [this]() { return !IsEmpty() || shutdown; });
+                    if (shutdown) break;
+                    auto i = this->tail++ % works.size();
+                    work = std::move(works[i]);
+                    state->working = true;
+                }
+                // producers wait on the same condition variable
+                cv.notify_all();
+                work.func();
+                state->working = false;
+                if (work.callback)
+                {
+                    work.callback();
+                }
+            }
+        }
+    };
+} // Ajiva
+// Benchmark
@@ -0,0 +1,352 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#include "Benchmark.h"
+#include "LegacyThreadPool.h"
+#include "Core/ThreadPool.h"
+
+#include <iostream>
+#include <random>
+#include <thread>
+
+namespace Ajiva::Benchmark
+{
+    // both pools behind the same surface, completion is tracked by the benchmark itself
+    struct LegacyAdapter
+    {
+        static constexpr const char* Name = "legacy";
+        LegacyThreadPool pool;
+
+        LegacyAdapter(u64 workers, u64 capacity) : pool(workers, capacity)
+        {
+        }
+
+        template <typename F>
+        void Queue(F&& func)
+        {
+            pool.QueueWork(std::forward<F>(func));
+        }
+    };
+
+    struct CurrentAdapter
+    {
+        static constexpr const char* Name = "current";
+        Core::ThreadPool pool;
+
+        CurrentAdapter(u64 workers, u64 capacity)
+            : pool({
+                .WorkerCount = static_cast<u32>(workers), .ReservedCores = 0, .QueueCapacity = capacity,
+                .Name = "Bench"
+            })
+        {
+        }
+
+        template <typename F>
+        void Queue(F&& func)
+        {
+            pool.QueueWork(std::forward<F>(func));
+        }
+    };
+
+    static void WaitFor(const std::atomic<u64>& counter, u64 target)
+    {
+        while (counter.load(std::memory_order_acquire) < target)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    static void Spin(u64 ns)
+    {
+        const auto until = std::chrono::steady_clock::now() + std::chrono::nanoseconds(ns);
+        while (std::chrono::steady_clock::now() < until)
+        {
+        }
+    }
+
+    struct Result
+    {
+        std::string Name;
+        f64 Ms = 0;
+        f64 TasksPerSecond = 0;
+        f64 AllocationsPerTask = 0;
+        std::vector<f64> LatencyUs{}; // per round, only fan-out/fan-in
+        f64 Efficiency = 0; // only mixed sizes, ideal makespan / measured
+        bool SteadyState = false; // measured after the warm-up, the current pool must not allocate here
+    };
+
+    // one producer, no-op tasks: pure scheduling overhead
+    template <typename Pool>
+    static Result EmptyTasks(Pool& pool, const Options& options)
+    {
+        std::atomic<u64> done{0};
+        const u64 allocations = AllocationCount();
+        Stopwatch watch;
+        for (u64 i = 0; i < options.Tasks; ++i)
+        {
+            pool.Queue([&done]() { done.fetch_add(1, std::memory_order_release); });
+        }
+        WaitFor(done, options.Tasks);
+        Result result{"empty_tasks", watch.ElapsedMs()};
+        result.TasksPerSecond = Ratio(static_cast<f64>(options.Tasks), result.Ms / 1000.0);
+        result.AllocationsPerTask = Ratio(static_cast<f64>(AllocationCount() - allocations),
+                                          static_cast<f64>(options.Tasks));
+        return result;
+    }
+
+    // more producers than the small queue can absorb, exercises the IsFull wait path
+    template <typename Pool>
+    static Result FullQueue(Pool& pool, const Options& options, u64 producers)
+    {
+        std::atomic<u64> done{0};
+        const u64 perProducer = options.Tasks / producers;
+        const u64 total = perProducer * producers;
+        const u64 allocations = AllocationCount();
+        Stopwatch watch;
+        std::vector<std::thread> threads;
+        for (u64 p = 0; p < producers; ++p)
+        {
+            threads.emplace_back([&pool, &done, perProducer]()
+            {
+                for (u64 i = 0; i < perProducer; ++i)
+                {
+                    pool.Queue([&done]()
+                    {
+                        Spin(200);
+                        done.fetch_add(1, std::memory_order_release);
+                    });
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        WaitFor(done, total);
+        Result result{"full_queue", watch.ElapsedMs()};
+        result.TasksPerSecond = Ratio(static_cast<f64>(total), result.Ms / 1000.0);
+        result.AllocationsPerTask = Ratio(static_cast<f64>(AllocationCount() - allocations), static_cast<f64>(total));
+        return result;
+    }
+
+    // latency of a burst of small tasks until the last one finished
+    template <typename Pool>
+    static Result FanOutFanIn(Pool& pool, const Options& options, u64 width)
+    {
+        Result result{"fan_out_fan_in"};
+        result.LatencyUs.reserve(options.Rounds);
+        const u64 allocations = AllocationCount();
+        Stopwatch total;
+        for (u64 round = 0; round < options.Rounds; ++round)
+        {
+            std::atomic<u64> done{0};
+            Stopwatch watch;
+            for (u64 i = 0; i < width; ++i)
+            {
+                pool.Queue([&done]()
+                {
+                    Spin(1000);
+                    done.fetch_add(1, std::memory_order_release);
+                });
+            }
+            WaitFor(done, width);
+            result.LatencyUs.push_back(watch.ElapsedMs() * 1000.0);
+        }
+        result.Ms = total.ElapsedMs();
+        const u64 tasks = options.Rounds * width;
+        result.TasksPerSecond = Ratio(static_cast<f64>(tasks), result.Ms / 1000.0);
+        result.AllocationsPerTask = Ratio(static_cast<f64>(AllocationCount() - allocations), static_cast<f64>(tasks));
+        return result;
+    }
+
+    // same shape through the dependency graph, only the current pool has one
+    static Result FanOutFanInGraph(Core::ThreadPool& pool, const Options& options, u64 width)
+    {
+        Result result{"fan_out_fan_in_graph"};
+        result.LatencyUs.reserve(options.Rounds);
+        std::vector<Core::WorkHandle> handles;
+        handles.reserve(width);
+        const u64 allocations = AllocationCount();
+        Stopwatch total;
+        for (u64 round = 0; round < options.Rounds; ++round)
+        {
+            handles.clear();
+            Stopwatch watch;
+            for (u64 i = 0; i < width; ++i)
+            {
+                handles.push_back(pool.Submit([]() { Spin(1000); }));
+            }
+            pool.WhenAll(handles).Wait();
+            result.LatencyUs.push_back(watch.ElapsedMs() * 1000.0);
+        }
+        result.Ms = total.ElapsedMs();
+        const u64 tasks = options.Rounds * width;
+        result.TasksPerSecond = Ratio(static_cast<f64>(tasks), result.Ms / 1000.0);
+        result.AllocationsPerTask = Ratio(static_cast<f64>(AllocationCount() - allocations), static_cast<f64>(tasks));
+        return result;
+    }
+
+    // 90% tiny, 9% medium, 1% large tasks, efficiency against a perfect split of the total work
+    template <typename Pool>
+    static Result MixedSizes(Pool& pool, const Options& options, u64 workers)
+    {
+        // at least one task, so a small --tasks still measures something
+        const u64 count = std::max<u64>(options.Tasks / 10, 1);
+        std::vector<u64> sizes(count);
+        std::mt19937_64 random(42);
+        u64 workNs = 0;
+        for (auto& size : sizes)
+        {
+            const u64 roll = random() % 100;
+            size = roll < 90 ? 500 : roll < 99 ? 20000 : 500000;
+            workNs += size;
+        }
+        std::atomic<u64> done{0};
+        const u64 allocations = AllocationCount();
+        Stopwatch watch;
+        for (u64 size : sizes)
+        {
+            pool.Queue([&done, size]()
+            {
+                Spin(size);
+                done.fetch_add(1, std::memory_order_release);
+            });
+        }
+        WaitFor(done, count);
+        Result result{"mixed_sizes", watch.ElapsedMs()};
+        result.TasksPerSecond = Ratio(static_cast<f64>(count), result.Ms / 1000.0);
+        result.AllocationsPerTask = Ratio(static_cast<f64>(AllocationCount() - allocations), static_cast<f64>(count));
+        result.Efficiency = Ratio(static_cast<f64>(workNs) / 1e6 / static_cast<f64>(workers), result.Ms);
+        return result;
+    }
+
+    // fills the node pool, the per thread caches and the spare join edges, repeated until a whole pass ran without
+    // allocating. allocations after this are a regression
+    static void WarmUp(CurrentAdapter& adapter, const Options& options, u64 workers)
+    {
+        for (u32 pass = 0; pass < 16; ++pass)
+        {
+            const f64 allocations = EmptyTasks(adapter, options).AllocationsPerTask
+                + FanOutFanIn(adapter, options, workers * 4).AllocationsPerTask
+                + FanOutFanInGraph(adapter.pool, options, workers * 4).AllocationsPerTask
+                + MixedSizes(adapter, options, workers).AllocationsPerTask;
+            if (allocations == 0) return;
+        }
+    }
+
+    // the pool has to run small captures without touching the heap
+    static bool CheckSteadyState(const Result& result)
+    {
+        if (!result.SteadyState || result.AllocationsPerTask == 0) return true;
+        std::cerr << result.Name << ": " << result.AllocationsPerTask << " allocations per task after warm-up"
+            << std::endl;
+        return false;
+    }
+
+    static void Write(JsonWriter& json, Result& result)
+    {
+        json.BeginObject();
+        json.Value("name", result.Name);
+        json.Value("ms", result.Ms);
+        json.Value("tasks_per_second", result.TasksPerSecond);
+        json.Value("allocations_per_task", result.AllocationsPerTask);
+        if (!result.LatencyUs.empty())
+        {
+            json.Value("latency_p50_us", Percentile(result.LatencyUs, 0.5));
+            json.Value("latency_p99_us", Percentile(result.LatencyUs, 0.99));
+            json.Value("latency_max_us", Percentile(result.LatencyUs, 1.0));
+        }
+        if (result.Efficiency > 0)
+        {
+            json.Value("efficiency", result.Efficiency);
+        }
+        json.EndObject();
+    }
+
+    template <typename Adapter>
+    static bool RunSuite(const Options& options, u64 workers, JsonWriter& json)
+    {
+        constexpr bool Current = std::is_same_v<Adapter, CurrentAdapter>;
+        std::cerr << Adapter::Name << ", " << workers << " workers" << std::endl;
+        bool steady = true;
+        auto report = [&](Result& result)
+        {
+            result.SteadyState = Current && result.SteadyState;
+            steady &= CheckSteadyState(result);
+            Write(json, result);
+        };
+        json.BeginObject();
+        json.Value("pool", std::string(Adapter::Name));
+        json.Value("workers", workers);
+        json.BeginArray("results");
+        {
+            Adapter adapter(workers, 1024);
+            if constexpr (Current)
+            {
+                WarmUp(adapter, options, workers);
+            }
+            auto empty = EmptyTasks(adapter, options);
+            empty.SteadyState = true;
+            report(empty);
+            auto fan = FanOutFanIn(adapter, options, workers * 4);
+            fan.SteadyState = true;
+            report(fan);
+            if constexpr (Current)
+            {
+                auto graph = FanOutFanInGraph(adapter.pool, options, workers * 4);
+                graph.SteadyState = true;
+                report(graph);
+            }
+            auto mixed = MixedSizes(adapter, options, workers);
+            mixed.SteadyState = true;
+            report(mixed);
+        }
+        {
+            // cold pool and producer threads, reported but not checked
+            Adapter adapter(workers, 64);
+            auto full = FullQueue(adapter, options, std::max<u64>(4, workers * 2));
+            report(full);
+            if constexpr (Current)
+            {
+                auto stats = adapter.pool.GetStats();
+                json.BeginObject();
+                json.Value("name", std::string("full_queue_pool_stats"));
+                json.Value("blocked_producer_count", stats.BlockedProducerCount);
+                json.Value("blocked_producer_ms", stats.BlockedProducerMs);
+                json.Value("queued_high_water", stats.QueuedHighWater);
+                json.EndObject();
+            }
+        }
+        json.EndArray();
+        json.EndObject();
+        return steady;
+    }
+
+    bool RunThreadPoolBenchmarks(const Options& options, JsonWriter& json)
+    {
+        std::vector<u64> workers = options.Workers;
+        if (workers.empty())
+        {
+            const u64 hardware = std::max(1u, std::thread::hardware_concurrency());
+            for (u64 count = 1; count < hardware; count *= 2)
+            {
+                workers.push_back(count);
+            }
+            workers.push_back(hardware);
+        }
+
+        bool steady = true;
+        json.BeginArray("thread_pool");
+        for (u64 count : workers)
+        {
+            if (options.Legacy)
+                steady &= RunSuite<LegacyAdapter>(options, count, json);
+            if (options.Current)
+                steady &= RunSuite<CurrentAdapter>(options, count, json);
+        }
+        json.EndArray();
+        return steady;
+    }
+} // Ajiva
+// Benchmark
@@ -0,0 +1,137 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#include "Benchmark.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+
+// every allocation in the process is counted, used for the allocations per task figures
+static std::atomic<u64> g_allocations{0};
+
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+u64 Ajiva::Benchmark::AllocationCount()
+{
+    return g_allocations.load(std::memory_order_relaxed);
+}
+
+static void PrintUsage()
+{
+    std::cerr << "Usage: Benchmark [--suite threadpool|events] [--workers 1,2,4] [--tasks N] [--rounds N]\n"
+        "                 [--events N] [--pool legacy|current|both] [--out file.json]\n";
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace Ajiva::Benchmark;
+
+    Options options;
+    std::string suite = "all";
+    std::string out;
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!std::strcmp(arg, "--help"))
+        {
+            PrintUsage();
+            return 0;
+        }
+        if (!value)
+        {
+            PrintUsage();
+            return 1;
+        }
+        ++i;
+        if (!std::strcmp(arg, "--suite"))
+        {
+            suite = value;
+        }
+        else if (!std::strcmp(arg, "--workers"))
+        {
+            std::stringstream list(value);
+            std::string item;
+            while (std::getline(list, item, ','))
+            {
+                options.Workers.push_back(std::stoull(item));
+            }
+        }
+        else if (!std::strcmp(arg, "--tasks"))
+        {
+            options.Tasks = std::stoull(value);
+        }
+        else if (!std::strcmp(arg, "--rounds"))
+        {
+            options.Rounds = std::stoull(value);
+        }
+        else if (!std::strcmp(arg, "--events"))
+        {
+            options.Events = std::stoull(value);
+        }
+        else if (!std::strcmp(arg, "--pool"))
+        {
+            options.Legacy = std::strcmp(value, "current") != 0;
+            options.Current = std::strcmp(value, "legacy") != 0;
+        }
+        else if (!std::strcmp(arg, "--out"))
+        {
+            out = value;
+        }
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    std::ofstream file;
+    if (!out.empty())
+    {
+        file.open(out);
+        if (!file)
+        {
+            std::cerr << "Could not open " << out << std::endl;
+            return 1;
+        }
+    }
+    JsonWriter json(out.empty() ? std::cout : file);
+
+    bool steady = true;
+    json.BeginObject();
+    json.Value("hardware_concurrency", static_cast<u64>(std::thread::hardware_concurrency()));
+    if (suite == "all" || suite == "threadpool")
+    {
+        steady = RunThreadPoolBenchmarks(options, json);
+    }
+    if (suite == "all" || suite == "events")
+    {
+        RunEventBenchmarks(options, json);
+    }
+    json.EndObject();
+    (out.empty() ? std::cout : file) << std::endl;
+    return steady ? 0 : 2;
+}
@@ -0,0 +1,181 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#include "AsyncAppender.h"
+
+#include <chrono>
+
+namespace Ajiva::Core
+{
+    namespace
+    {
+        // hands the captured values to the formatter instead of the ones of the writer thread
+        class AsyncRecord : public plog::Record
+        {
+        public:
+            explicit AsyncRecord(const LogEntry& entry)
+                : Record(entry.Severity, "", entry.Line, entry.File, entry.Object, entry.InstanceId),
+                  entry(entry)
+            {
+            }
+
+            const plog::util::Time& getTime() const override
+            {
+                return entry.Time;
+            }
+
+            unsigned int getTid() const override
+            {
+                return entry.Tid;
+            }
+
+            const plog::util::nchar* getMessage() const override
+            {
+                return entry.Message.c_str();
+            }
+
+            const char* getFunc() const override
+            {
+                return entry.Func.c_str();
+            }
+
+        private:
+            const LogEntry& entry;
+        };
+    }
+
+    AsyncAppender::AsyncAppender(plog::IAppender* sink, u64 capacity, LogOverflowPolicy overflow)
+        : sink(sink), overflow(overflow), queue(capacity)
+    {
+        thread = std::thread(&AsyncAppender::Run, this);
+    }
+
+    AsyncAppender::~AsyncAppender()
+    {
+        Shutdown();
+    }
+
+    void AsyncAppender::write(const plog::Record& record)
+    {
+        LogEntry entry{
+            record.getTime(), record.getSeverity(), record.getTid(), record.getFunc(), record.getFile(),
+            record.getObject(), record.getLine(), record.getInstanceId(), record.getMessage()
+        };
+        if (!running.load(std::memory_order_acquire) || IsWriterThread())
+        {
+            std::lock_guard<std::mutex> lock(syncMutex);
+            sink->write(record);
+            return;
+        }
+
+        u64 position = 0;
+        while (!queue.TryPush(std::move(entry), &position))
+        {
+            if (overflow == LogOverflowPolicy::Drop && record.getSeverity() > plog::error)
+            {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            // errors and fatals always wait for space, they are what a crash report needs
+            Wake();
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+            if (!running.load(std::memory_order_acquire))
+            {
+                std::lock_guard<std::mutex> lock(syncMutex);
+                sink->write(record);
+                return;
+            }
+        }
+        Wake();
+
+        // this record and everything pushed before it, no matter which thread counted what
+        if (record.getSeverity() == plog::fatal)
+            WaitWritten(position + 1);
+    }
+
+    void AsyncAppender::Flush()
+    {
+        if (IsWriterThread()) return;
+        WaitWritten(queue.EnqueuePosition());
+    }
+
+    void AsyncAppender::WaitWritten(u64 count)
+    {
+        Wake();
+        std::unique_lock<std::mutex> lock(flushMutex);
+        flushCv.wait(lock, [this, count]()
+        {
+            return written.load(std::memory_order_acquire) >= count || !running.load(std::memory_order_acquire);
+        });
+    }
+
+    void AsyncAppender::Shutdown()
+    {
+        if (!thread.joinable()) return;
+        Flush();
+        running.store(false, std::memory_order_release);
+        Wake();
+        thread.join();
+        // pushed by threads that saw the appender running a moment before it stopped
+        LogEntry entry;
+        while (queue.TryPop(entry))
+            WriteEntry(entry);
+    }
+
+    void AsyncAppender::Wake()
+    {
+        if (sleeping.load(std::memory_order_seq_cst))
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            wakeCv.notify_one();
+        }
+    }
+
+    void AsyncAppender::Run()
+    {
+        LogEntry entry;
+        for (;;)
+        {
+            bool any = false;
+            while (queue.TryPop(entry))
+            {
+                WriteEntry(entry);
+                any = true;
+            }
+            if (any)
+            {
+                std::lock_guard<std::mutex> lock(flushMutex);
+                flushCv.notify_all();
+            }
+
+            const u64 lost = dropped.load(std::memory_order_relaxed);
+            if (lost != reportedDropped)
+            {
+                PLOG_WARNING << "AsyncAppender: dropped " << lost - reportedDropped << " records, queue was full";
+                reportedDropped = lost;
+            }
+
+            if (!running.load(std::memory_order_acquire) && queue.Size() == 0)
+                break;
+
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            sleeping.store(true, std::memory_order_seq_cst);
+            if (queue.Size() == 0 && running.load(std::memory_order_acquire))
+                wakeCv.wait_for(lock, std::chrono::milliseconds(100));
+            sleeping.store(false, std::memory_order_relaxed);
+        }
+        std::lock_guard<std::mutex> lock(flushMutex);
+        flushCv.notify_all();
+    }
+
+    void AsyncAppender::WriteEntry(const LogEntry& entry)
+    {
+        {
+            std::lock_guard<std::mutex> lock(syncMutex);
+            sink->write(AsyncRecord(entry));
+        }
+        written.fetch_add(1, std::memory_order_release);
+    }
+} // Ajiva
+// Core
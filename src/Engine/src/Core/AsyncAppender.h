@@ -0,0 +1,93 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#pragma once
+
+#include "defines.h"
+#include "Core/Logger.h"
+#include "Core/MpmcQueue.h"
+
+#include <plog/Appenders/IAppender.h>
+#include <plog/Record.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Ajiva::Core
+{
+    // Record as it left the calling thread, the message is already rendered
+    struct LogEntry
+    {
+        plog::util::Time Time{};
+        plog::Severity Severity = plog::none;
+        unsigned int Tid = 0;
+        std::string Func; // already processed by plog
+        const char* File = nullptr; // __FILE__, a literal
+        const void* Object = nullptr;
+        size_t Line = 0;
+        int InstanceId = 0;
+        plog::util::nstring Message;
+    };
+
+    // Callers only render the message and push it into a lock-free ring, a background thread formats and writes
+    // the records to the sink. Fatal records and Flush() wait until everything before them reached the sink.
+    class AJ_API AsyncAppender : public plog::IAppender
+    {
+    public:
+        AsyncAppender(plog::IAppender* sink, u64 capacity = AJ_LOG_QUEUE_LENGTH,
+                      LogOverflowPolicy overflow = LogOverflowPolicy::Drop);
+
+        ~AsyncAppender() override;
+
+        AsyncAppender(const AsyncAppender&) = delete;
+        AsyncAppender& operator=(const AsyncAppender&) = delete;
+
+        void write(const plog::Record& record) override;
+
+        // blocks until every record written before the call reached the sink
+        void Flush();
+
+        // drains the ring and stops the thread, later records are written synchronously
+        void Shutdown();
+
+        [[nodiscard]] u64 DroppedCount() const
+        {
+            return dropped.load(std::memory_order_relaxed);
+        }
+
+    private:
+        plog::IAppender* sink;
+        LogOverflowPolicy overflow;
+        MpmcQueue<LogEntry> queue;
+        std::thread thread;
+        std::atomic<bool> running{true};
+        std::atomic<u64> written{0}; // one writer pops in push order, position p reached the sink once written > p
+        std::atomic<u64> dropped{0};
+        u64 reportedDropped = 0;
+
+        std::atomic<bool> sleeping{false};
+        std::mutex wakeMutex;
+        std::condition_variable wakeCv;
+        std::mutex flushMutex;
+        std::condition_variable flushCv;
+        std::mutex syncMutex; // direct writes once stopped or from the writer thread
+
+        void Run();
+
+        // blocks until the first count pushed records reached the sink
+        void WaitWritten(u64 count);
+
+        void WriteEntry(const LogEntry& entry);
+
+        void Wake();
+
+        [[nodiscard]] bool IsWriterThread() const
+        {
+            return std::this_thread::get_id() == thread.get_id();
+        }
+    };
+} // Ajiva
+// Core
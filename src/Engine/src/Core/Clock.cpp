@@ -1,6 +1,6 @@
 #include "Clock.h"
 
-using ClockType = std::chrono::high_resolution_clock;
+using ClockType = std::chrono::steady_clock;
 using TimePoint = ClockType::time_point;
 using Duration = ClockType::duration;
 
@@ -7,7 +7,8 @@ namespace Ajiva::Core
 {
     struct AJ_API Clock
     {
-        using ClockType = std::chrono::high_resolution_clock;
+        // monotonic, high_resolution_clock may follow the wall clock
+        using ClockType = std::chrono::steady_clock;
         using TimePoint = ClockType::time_point;
         using Duration = ClockType::duration;
 
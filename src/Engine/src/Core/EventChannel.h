@@ -0,0 +1,186 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#pragma once
+
+#include "defines.h"
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Ajiva::Core
+{
+    namespace Detail
+    {
+        template <typename M>
+        struct ChannelMethod;
+
+        template <typename C, typename R, typename E>
+        struct ChannelMethod<R (C::*)(const E&)>
+        {
+            using Class = C;
+            using Result = R;
+            using Event = E;
+        };
+    }
+
+    // Statically typed publish/subscribe for one event struct. The member function is a template argument, so
+    // its call is inlined into the per-subscriber thunk; dispatch is one indirect call per subscriber over a
+    // contiguous array, nothing is type erased or allocated. Subscribers run in subscription order, returning
+    // true from a bool handler stops the event. Single threaded, like EventSystem.
+    template <typename E>
+    class EventChannel
+    {
+        using Thunk = bool (*)(void* instance, const E& event);
+
+        struct Subscriber
+        {
+            void* instance;
+            Thunk thunk; // nullptr: removed while publishing, compacted afterwards
+            u64 id;
+        };
+
+    public:
+        // Keeps the subscriber registered, has to die before the channel. Move only.
+        class Subscription
+        {
+        public:
+            Subscription() = default;
+
+            Subscription(EventChannel* channel, u64 id) : channel(channel), id(id)
+            {
+            }
+
+            Subscription(Subscription&& other) noexcept
+                : channel(std::exchange(other.channel, nullptr)), id(std::exchange(other.id, 0))
+            {
+            }
+
+            Subscription& operator=(Subscription&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    Reset();
+                    channel = std::exchange(other.channel, nullptr);
+                    id = std::exchange(other.id, 0);
+                }
+                return *this;
+            }
+
+            Subscription(const Subscription&) = delete;
+            Subscription& operator=(const Subscription&) = delete;
+
+            ~Subscription()
+            {
+                Reset();
+            }
+
+            void Reset()
+            {
+                if (channel) channel->Unsubscribe(id);
+                channel = nullptr;
+                id = 0;
+            }
+
+        private:
+            EventChannel* channel = nullptr;
+            u64 id = 0;
+        };
+
+        EventChannel() = default;
+
+        EventChannel(const EventChannel&) = delete;
+        EventChannel& operator=(const EventChannel&) = delete;
+
+        // channel.Subscribe<&Camera::OnMouseMove>(this)
+        template <auto Method, typename C>
+        [[nodiscard]] Subscription Subscribe(C* instance)
+        {
+            using Traits = Detail::ChannelMethod<decltype(Method)>;
+            static_assert(std::is_same_v<typename Traits::Event, E>, "Handler takes a different event type.");
+            static_assert(std::is_base_of_v<typename Traits::Class, C>, "Handler belongs to another class.");
+            static_assert(std::is_same_v<typename Traits::Result, bool> ||
+                          std::is_same_v<typename Traits::Result, void>, "Return type must be bool or void.");
+
+            const u64 id = ++lastId;
+            subscribers.push_back({static_cast<typename Traits::Class*>(instance), &Call<Method>, id});
+            return {this, id};
+        }
+
+        bool Publish(const E& event)
+        {
+            // subscribing from a handler appends, the new subscriber first sees the next event
+            const u64 count = subscribers.size();
+            bool consumed = false;
+            ++publishing;
+            for (u64 i = 0; i < count; ++i)
+            {
+                const auto& subscriber = subscribers[i];
+                if (subscriber.thunk && subscriber.thunk(subscriber.instance, event))
+                {
+                    consumed = true;
+                    break;
+                }
+            }
+            if (--publishing == 0 && dirty)
+            {
+                std::erase_if(subscribers, [](const Subscriber& subscriber) { return !subscriber.thunk; });
+                dirty = false;
+            }
+            return consumed;
+        }
+
+        [[nodiscard]] u64 SubscriberCount() const
+        {
+            u64 count = 0;
+            for (const auto& subscriber : subscribers)
+            {
+                if (subscriber.thunk) ++count;
+            }
+            return count;
+        }
+
+    private:
+        std::vector<Subscriber> subscribers;
+        u64 lastId = 0;
+        u32 publishing = 0;
+        bool dirty = false;
+
+        template <auto Method>
+        static bool Call(void* instance, const E& event)
+        {
+            using Traits = Detail::ChannelMethod<decltype(Method)>;
+            auto* target = static_cast<typename Traits::Class*>(instance);
+            if constexpr (std::is_same_v<typename Traits::Result, bool>)
+            {
+                return (target->*Method)(event);
+            }
+            else
+            {
+                (target->*Method)(event);
+                return false;
+            }
+        }
+
+        void Unsubscribe(u64 id)
+        {
+            for (auto it = subscribers.begin(); it != subscribers.end(); ++it)
+            {
+                if (it->id != id || !it->thunk) continue;
+                if (publishing)
+                {
+                    it->thunk = nullptr;
+                    dirty = true;
+                }
+                else
+                {
+                    subscribers.erase(it);
+                }
+                return;
+            }
+        }
+    };
+} // Ajiva
+// Core
@@ -0,0 +1,90 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#include "EventRecorder.h"
+#include "Core/Logger.h"
+
+#include <cstring>
+
+namespace Ajiva::Core
+{
+    EventRecorder::EventRecorder(const std::filesystem::path& path) : file(path, std::ios::binary | std::ios::trunc)
+    {
+        if (!file)
+        {
+            PLOG_ERROR << "Could not open event recording: " << path;
+            return;
+        }
+        EventRecordHeader header;
+        header.RecordSize = sizeof(EventRecord);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        PLOG_INFO << "Recording events to " << path;
+    }
+
+    EventRecorder::~EventRecorder()
+    {
+        if (!file.is_open()) return;
+        file.flush();
+        PLOG_INFO << "Recorded " << count << " events";
+    }
+
+    void EventRecorder::Record(u64 frame, const PostedEvent& event)
+    {
+        if (!file.is_open()) return;
+        if (!count) startNs = event.timestampNs;
+        EventRecord record = {};
+        record.Frame = frame;
+        record.TimeNs = event.timestampNs >= startNs ? event.timestampNs - startNs : 0;
+        record.Code = event.code;
+        record.Context = event.context;
+        file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        ++count;
+    }
+
+    void EventRecorder::Flush()
+    {
+        if (file.is_open()) file.flush();
+    }
+
+    EventReplayer::EventReplayer(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            PLOG_ERROR << "Could not open event recording: " << path;
+            return;
+        }
+        EventRecordHeader header;
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!file || std::memcmp(header.Magic, "AJEV", 4) != 0 || header.Version != 1 ||
+            header.RecordSize != sizeof(EventRecord))
+        {
+            PLOG_ERROR << "Not an event recording (or another version): " << path;
+            return;
+        }
+        EventRecord record;
+        while (file.read(reinterpret_cast<char*>(&record), sizeof(record)))
+        {
+            records.push_back(record);
+        }
+        open = true;
+        PLOG_INFO << "Replaying " << records.size() << " events over " << LastFrame() + 1 << " frames from " << path;
+    }
+
+    u64 EventReplayer::Feed(EventSystem& eventSystem, u64 frame, void* sender)
+    {
+        if (!baseNs) baseNs = EventTimestampNow();
+        u64 posted = 0;
+        while (next < records.size() && records[next].Frame <= frame)
+        {
+            const auto& record = records[next++];
+            eventSystem.PostRecorded({
+                static_cast<EventCode>(record.Code), sender, record.Context, baseNs + record.TimeNs
+            });
+            ++posted;
+        }
+        return posted;
+    }
+} // Ajiva
+// Core
@@ -0,0 +1,103 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#pragma once
+
+#include "defines.h"
+#include "Core/EventSystem.h"
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace Ajiva::Core
+{
+    // On disk: one EventRecordHeader followed by fixed size records, host byte order (all targets are little
+    // endian). Times are relative to the first recorded event, frames count EventSystem::DispatchPosted calls.
+    struct EventRecordHeader
+    {
+        char Magic[4] = {'A', 'J', 'E', 'V'};
+        u32 Version = 1;
+        u32 RecordSize = 0;
+        u32 Reserved = 0;
+    };
+
+    struct EventRecord
+    {
+        u64 Frame;
+        u64 TimeNs;
+        u16 Code;
+        u16 Reserved[3];
+        EventContext Context;
+    };
+
+    static_assert(sizeof(EventRecordHeader) == 16);
+    static_assert(sizeof(EventRecord) == 40);
+
+    // Captures the raw posted stream (before coalescing), attach with EventSystem::SetRecorder. Main thread only.
+    class AJ_API EventRecorder
+    {
+    public:
+        explicit EventRecorder(const std::filesystem::path& path);
+
+        ~EventRecorder();
+
+        [[nodiscard]] bool IsOpen() const
+        {
+            return file.is_open();
+        }
+
+        void Record(u64 frame, const PostedEvent& event);
+
+        void Flush();
+
+        [[nodiscard]] u64 RecordCount() const
+        {
+            return count;
+        }
+
+    private:
+        std::ofstream file;
+        u64 count = 0;
+        u64 startNs = 0;
+    };
+
+    // Feeds a recording back into an EventSystem at the frames it was captured in, no window needed.
+    class AJ_API EventReplayer
+    {
+    public:
+        explicit EventReplayer(const std::filesystem::path& path);
+
+        [[nodiscard]] bool IsOpen() const
+        {
+            return open;
+        }
+
+        // posts every record up to and including frame, call right before DispatchPosted with
+        // eventSystem.DispatchFrame(). returns the number of posted events
+        u64 Feed(EventSystem& eventSystem, u64 frame, void* sender = nullptr);
+
+        [[nodiscard]] bool IsFinished() const
+        {
+            return next >= records.size();
+        }
+
+        [[nodiscard]] u64 LastFrame() const
+        {
+            return records.empty() ? 0 : records.back().Frame;
+        }
+
+        [[nodiscard]] u64 RecordCount() const
+        {
+            return records.size();
+        }
+
+    private:
+        std::vector<EventRecord> records;
+        u64 next = 0;
+        u64 baseNs = 0;
+        bool open = false;
+    };
+} // Ajiva
+// Core
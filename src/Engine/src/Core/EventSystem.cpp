@@ -3,38 +3,233 @@
 //
 
 #include "EventSystem.h"
+#include "Core/EventRecorder.h"
 #include "Core/Logger.h"
 #include "magic_enum.hpp"
 
 namespace Ajiva::Core
 {
+    void EventSubscription::Reset()
+    {
+        if (system && handle)
+        {
+            system->Remove(handle);
+        }
+        system = nullptr;
+        handle = 0;
+    }
+
+    EventSystem::EventSystem(u64 postedCapacity) : posted(postedCapacity)
+    {
+    }
+
+    ListenerHandle EventSystem::Add(EventCode eventCode, void* instance, Thunk thunk, const void* callback,
+                                    u64 callbackSize, bool raw)
+    {
+        if (eventCode >= MAX_MESSAGE_CODES)
+        {
+            AJ_FAIL("EventCode >= MAX_MESSAGE_CODES, Increase MAX_MESSAGE_CODES!");
+        }
+        if (callbackSize > CallbackStorage)
+        {
+            AJ_FAIL("Member function pointer does not fit into the listener entry!");
+        }
+        if (eventCode >= lookup.size())
+        {
+            lookup.resize(eventCode + 1, 0);
+        }
+        if (!lookup[eventCode])
+        {
+            lists.emplace_back();
+            lookup[eventCode] = static_cast<u16>(lists.size());
+        }
+        const u16 listIndex = lookup[eventCode] - 1;
+        auto& list = lists[listIndex];
+
+        u32 slotIndex;
+        if (!freeSlots.empty())
+        {
+            slotIndex = freeSlots.back();
+            freeSlots.pop_back();
+        }
+        else
+        {
+            slotIndex = static_cast<u32>(slots.size());
+            slots.emplace_back();
+        }
+        auto& slot = slots[slotIndex];
+        slot.list = listIndex;
+        slot.position = static_cast<u32>(list.entries.size());
+
+        Entry entry{instance, thunk, slotIndex, raw, {}};
+        std::memcpy(entry.callback, callback, callbackSize);
+        // appended entries are not visited by a dispatch that is already running (it captured the size)
+        list.entries.push_back(entry);
+        return static_cast<u64>(slot.generation) << 32 | slotIndex;
+    }
+
+    bool EventSystem::Remove(ListenerHandle handle)
+    {
+        const u32 slotIndex = static_cast<u32>(handle);
+        const u32 generation = static_cast<u32>(handle >> 32);
+        if (slotIndex >= slots.size() || slots[slotIndex].generation != generation)
+            return false;
+
+        auto& slot = slots[slotIndex];
+        auto& list = lists[slot.list];
+        if (dispatchDepth)
+        {
+            // the running loop indexes into the array, only mark the entry here
+            list.entries[slot.position].thunk = nullptr;
+            list.dirty = true;
+            compactPending = true;
+        }
+        else
+        {
+            list.entries.erase(list.entries.begin() + slot.position);
+            for (u32 i = slot.position; i < list.entries.size(); ++i)
+            {
+                slots[list.entries[i].slot].position = i;
+            }
+        }
+
+        // generation 0 stays reserved so a zero handle is never valid
+        if (++slot.generation == 0) slot.generation = 1;
+        freeSlots.push_back(slotIndex);
+        return true;
+    }
+
     bool EventSystem::FireEvent(EventCode eventCode, void* sender, const EventContext& context)
+    {
+        // no clock read on the hot path, CurrentEventTimeNs reads it only when asked
+        const u64 outer = std::exchange(currentEventTimeNs, 0);
+        const bool result = Dispatch(eventCode, sender, context);
+        currentEventTimeNs = outer;
+        return result;
+    }
+
+    void EventSystem::PostEvent(EventCode eventCode, void* sender, const EventContext& context)
+    {
+        if (!liveInput.load(std::memory_order_relaxed)) return;
+        PostRecorded({eventCode, sender, context, EventTimestampNow()});
+    }
+
+    void EventSystem::PostRecorded(const PostedEvent& event)
+    {
+        // keep posts behind the overflow once it is in use, otherwise they would overtake older events
+        if (overflowCount.load(std::memory_order_acquire) == 0 && posted.TryPush(event))
+            return;
+        std::lock_guard<std::mutex> lock(overflowMutex);
+        overflow.push_back(event);
+        overflowCount.fetch_add(1, std::memory_order_release);
+    }
+
+    u64 EventSystem::DispatchPosted()
+    {
+        // events posted while we dispatch wait for the next call, a busy input thread cannot keep us here
+        u64 budget = PendingPosted();
+        u64 dispatched = 0;
+        PostedEvent event;
+        while (dispatched < budget && TryTakePosted(event))
+        {
+            currentEventTimeNs = event.timestampNs;
+            ++dispatched;
+            if (recorder) recorder->Record(dispatchFrame, event);
+            const auto coalesce = event.code < coalescing.size() ? coalescing[event.code] : nullptr;
+            if (!coalesce)
+            {
+                Dispatch(event.code, event.sender, event.context);
+                continue;
+            }
+            Dispatch(event.code, event.sender, event.context, Receivers::Raw);
+            if (auto& index = mergedIndex[event.code])
+            {
+                auto& pending = merged[index - 1];
+                coalesce(pending.context, event.context);
+                pending.sender = event.sender;
+                pending.timestampNs = event.timestampNs;
+            }
+            else
+            {
+                merged.push_back(event);
+                index = static_cast<u32>(merged.size());
+            }
+        }
+
+        // listeners may post again, but merged is only touched from here, so iterating it is safe
+        for (const auto& pending : merged)
+        {
+            currentEventTimeNs = pending.timestampNs;
+            mergedIndex[pending.code] = 0;
+            Dispatch(pending.code, pending.sender, pending.context, Receivers::Merged);
+        }
+        merged.clear();
+        ++dispatchFrame;
+        return dispatched;
+    }
+
+    void EventSystem::SetCoalescing(EventCode eventCode, CoalesceFunction coalesce)
+    {
+        if (eventCode >= MAX_MESSAGE_CODES)
+        {
+            AJ_FAIL("EventCode >= MAX_MESSAGE_CODES, Increase MAX_MESSAGE_CODES!");
+        }
+        if (eventCode >= coalescing.size())
+        {
+            coalescing.resize(eventCode + 1, nullptr);
+            mergedIndex.resize(eventCode + 1, 0);
+        }
+        coalescing[eventCode] = coalesce;
+    }
+
+    u64 EventSystem::PendingPosted() const
+    {
+        return posted.Size() + overflowCount.load(std::memory_order_relaxed);
+    }
+
+    bool EventSystem::TryTakePosted(PostedEvent& event)
+    {
+        if (posted.TryPop(event))
+            return true;
+        if (overflowCount.load(std::memory_order_acquire) == 0)
+            return false;
+        std::lock_guard<std::mutex> lock(overflowMutex);
+        if (overflow.empty())
+            return false;
+        event = overflow.front();
+        overflow.pop_front();
+        overflowCount.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+
+    bool EventSystem::Dispatch(EventCode eventCode, void* sender, const EventContext& context, Receivers receivers)
     {
         if (eventCode >= MAX_MESSAGE_CODES)
         {
             AJ_FAIL("EventCode >= MAX_MESSAGE_CODES, Increase MAX_MESSAGE_CODES!");
         }
+        if (eventCode >= lookup.size() || !lookup[eventCode])
+            return false;
+
+        const u16 listIndex = lookup[eventCode] - 1;
+        const u64 count = lists[listIndex].entries.size();
         bool handled = false;
+        bool consumed = false;
+        ++dispatchDepth;
         try
         {
-            for (auto it = registered[eventCode].begin(); it != registered[eventCode].end();)
+            for (u64 i = 0; i < count; ++i)
             {
-                if (it->expired())
+                // listeners may add to this list, so the array is looked up again every iteration
+                const auto& entry = lists[listIndex].entries[i];
+                if (!entry.thunk) continue;
+                if (receivers != Receivers::All && entry.raw != (receivers == Receivers::Raw)) continue;
+                handled = true;
+                if (entry.thunk(entry.instance, entry.callback, eventCode, sender, context))
                 {
-                    PLOG_WARNING << "Event " << magic_enum::enum_name<>(eventCode)
-                                 << " has expired listener! Removing...";
-                    it = registered[eventCode].erase(it);
-                    continue;
+                    consumed = true;
+                    break;
                 }
-                if ((*it->lock())(eventCode, sender, context))
-                {
-                    return true;
-                }
-                else
-                {
-                    handled = true;
-                }
-                ++it;
             }
         }
         catch (std::exception& e)
@@ -43,20 +238,50 @@ namespace Ajiva::Core
                        << " with context "
                        << &context << "!";
             PLOG_ERROR << e.what();
-            return false;
+            handled = false;
+        }
+        if (--dispatchDepth == 0 && compactPending)
+        {
+            compactPending = false;
+            for (auto& list : lists)
+            {
+                if (list.dirty) Compact(list);
+            }
+        }
+        return consumed || handled;
+    }
+
+    u64 EventSystem::ListenerCount(EventCode eventCode) const
+    {
+        if (eventCode >= lookup.size() || !lookup[eventCode])
+            return 0;
+        u64 count = 0;
+        for (const auto& entry : lists[lookup[eventCode] - 1].entries)
+        {
+            if (entry.thunk) ++count;
+        }
+        return count;
+    }
+
+    void EventSystem::Compact(DispatchList& list)
+    {
+        std::erase_if(list.entries, [](const Entry& entry) { return !entry.thunk; });
+        for (u32 i = 0; i < list.entries.size(); ++i)
+        {
+            slots[list.entries[i].slot].position = i;
         }
-        return handled;
+        list.dirty = false;
     }
 
     EventSystem::~EventSystem()
     {
-        for (auto& registeredEvent : registered)
+        for (u64 code = 0; code < lookup.size(); ++code)
         {
-            if (!registeredEvent.empty())
+            if (lookup[code] && ListenerCount(static_cast<EventCode>(code)))
             {
-                PLOG_WARNING << "Event " << &registeredEvent << " not unregistered!";
+                PLOG_WARNING << "Event " << magic_enum::enum_name<>(static_cast<EventCode>(code))
+                             << " not unregistered!";
             }
-            registeredEvent.clear();
         }
     }
 }
@@ -11,7 +11,20 @@
 #define AJ_EVENT_PARAMETERS Ajiva::Core::EventCode code, void *sender, const Ajiva::Core::EventContext &event
 #define AJ_EVENT_PARAMETERS_CALL code, sender, event
 
+#ifndef AJ_EVENT_QUEUE_LENGTH
+#define AJ_EVENT_QUEUE_LENGTH 4096
+#endif
+
+#include "Core/MpmcQueue.h"
+
+#include <chrono>
+#include <cstring>
+#include <deque>
 #include <functional>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 
 namespace Ajiva::Core
@@ -104,116 +117,271 @@ namespace Ajiva::Core
 
     static_assert(sizeof(EventContext) == 16);
 
-    class IListener
+    // an event handed over from another thread, stamped when it was posted
+    struct PostedEvent
     {
-    public:
-        virtual ~IListener() = default;
+        EventCode code = None;
+        void* sender = nullptr;
+        EventContext context = {};
+        u64 timestampNs = 0; // steady clock
+    };
 
-        virtual bool operator()(AJ_EVENT_PARAMETERS) = 0;
+    AJ_INLINE u64 EventTimestampNow()
+    {
+        return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
 
-        //encorce equality operator
-        bool operator==(const IListener& other) const
-        {
-            return this == &other;
-        }
-    };
+    // merges the next posted event of a code into the pending one, see EventSystem::SetCoalescing
+    using CoalesceFunction = void (*)(EventContext& merged, const EventContext& next);
 
-    template <typename D, typename R>
-    class Listener : public IListener
+    // the latest event wins (resize, window rect)
+    AJ_INLINE void CoalesceLast(EventContext& merged, const EventContext& next)
+    {
+        merged = next;
+    }
+
+    // latest position, summed deltas
+    AJ_INLINE void CoalesceMouseMove(EventContext& merged, const EventContext& next)
+    {
+        merged.mouse.move.x = next.mouse.move.x;
+        merged.mouse.move.y = next.mouse.move.y;
+        merged.mouse.move.dx += next.mouse.move.dx;
+        merged.mouse.move.dy += next.mouse.move.dy;
+    }
+
+    AJ_INLINE void CoalesceScroll(EventContext& merged, const EventContext& next)
+    {
+        merged.mouse.wheel.xOffset += next.mouse.wheel.xOffset;
+        merged.mouse.wheel.yOffset += next.mouse.wheel.yOffset;
+    }
+
+    class EventRecorder;
+
+    using ListenerHandle = u64; // slot index in the low, generation in the high 32 bits, 0 is never valid
+
+    class EventSystem;
+
+    // Keeps a listener registered, unregisters it when destroyed. Has to die before its EventSystem.
+    class AJ_API EventSubscription
     {
     public:
-        typedef R (D::*Callback)(AJ_EVENT_PARAMETERS);
+        EventSubscription() = default;
 
-        bool operator()(AJ_EVENT_PARAMETERS) override
+        EventSubscription(EventSystem* system, ListenerHandle handle) : system(system), handle(handle)
         {
-            static_assert(std::is_same_v<R, bool> || std::is_same_v<R, void>,
-                          "Return type must be bool or void.");
+        }
 
-            if constexpr (std::is_same_v<R, bool>)
-            {
-                // Handle bool return type
-                return (_instance->*callback)(AJ_EVENT_PARAMETERS_CALL);
-            }
-            else
+        EventSubscription(EventSubscription&& other) noexcept
+            : system(std::exchange(other.system, nullptr)), handle(std::exchange(other.handle, 0))
+        {
+        }
+
+        EventSubscription& operator=(EventSubscription&& other) noexcept
+        {
+            if (this != &other)
             {
-                (_instance->*callback)(AJ_EVENT_PARAMETERS_CALL);
-                return false;
+                Reset();
+                system = std::exchange(other.system, nullptr);
+                handle = std::exchange(other.handle, 0);
             }
+            return *this;
         }
 
-        Listener(D* instance, Callback wmFuncPtr)
+        EventSubscription(const EventSubscription&) = delete;
+        EventSubscription& operator=(const EventSubscription&) = delete;
+
+        ~EventSubscription()
         {
-            _instance = instance;
-            callback = wmFuncPtr;
+            Reset();
         }
 
-        ~Listener() override = default;
+        void Reset();
+
+        [[nodiscard]] ListenerHandle Handle() const
+        {
+            return handle;
+        }
 
     private:
-        D* _instance;
-        Callback callback;
+        EventSystem* system = nullptr;
+        ListenerHandle handle = 0;
     };
 
-
-    class EventSystem
+    // Dispatch table that only holds codes with listeners. Each code owns a contiguous array of
+    // (instance, thunk, member function) entries, dispatch is a plain loop without atomics or allocations.
+    // Listeners run in registration order, returning true stops the event.
+    // Everything except PostEvent belongs to the main thread.
+    class AJ_API EventSystem
     {
     public:
-        EventSystem() = default;
+        explicit EventSystem(u64 postedCapacity = AJ_EVENT_QUEUE_LENGTH);
+
+        EventSystem(const EventSystem&) = delete;
+        EventSystem& operator=(const EventSystem&) = delete;
 
         ~EventSystem();
 
         template <typename D>
-        Ref<Listener<D, bool>> Add(EventCode eventCode, D* instance, Listener<D, bool>::Callback callback)
+        [[nodiscard]] EventSubscription Add(EventCode eventCode, D* instance,
+                                            bool (std::type_identity_t<D>::*callback)(AJ_EVENT_PARAMETERS))
+        {
+            return {this, Add(eventCode, instance, &Invoke<D, bool>, &callback, sizeof(callback))};
+        }
+
+        template <typename D>
+        [[nodiscard]] EventSubscription Add(EventCode eventCode, D* instance,
+                                            void (std::type_identity_t<D>::*callback)(AJ_EVENT_PARAMETERS))
         {
-            return Add<D, bool>(eventCode, instance, callback);
+            return {this, Add(eventCode, instance, &Invoke<D, void>, &callback, sizeof(callback))};
         }
 
+        // raw listeners see every posted event even when the code is coalesced
         template <typename D>
-        Ref<Listener<D, void>> Add(EventCode eventCode, D* instance, Listener<D, void>::Callback callback)
+        [[nodiscard]] EventSubscription AddRaw(EventCode eventCode, D* instance,
+                                               bool (std::type_identity_t<D>::*callback)(AJ_EVENT_PARAMETERS))
         {
-            return Add<D, void>(eventCode, instance, callback);
+            return {this, Add(eventCode, instance, &Invoke<D, bool>, &callback, sizeof(callback), true)};
         }
 
+        template <typename D>
+        [[nodiscard]] EventSubscription AddRaw(EventCode eventCode, D* instance,
+                                               void (std::type_identity_t<D>::*callback)(AJ_EVENT_PARAMETERS))
+        {
+            return {this, Add(eventCode, instance, &Invoke<D, void>, &callback, sizeof(callback), true)};
+        }
+
+        // stale handles (already removed, slot reused) are ignored
+        bool Remove(ListenerHandle handle);
+
         bool FireEvent(EventCode eventCode, void* sender, const EventContext& context);
 
+        // callable from any thread (window/input thread), one enqueue. Never blocks: a full ring spills into a
+        // locked overflow list like the MainThreadDispatcher does
+        void PostEvent(EventCode eventCode, void* sender, const EventContext& context);
+
+        // keeps the timestamp, always accepted (replays)
+        void PostRecorded(const PostedEvent& event);
+
+        // false drops PostEvent calls (live window input), PostRecorded still goes through
+        AJ_INLINE void SetLiveInput(bool enabled)
+        {
+            liveInput.store(enabled, std::memory_order_relaxed);
+        }
+
+        // every event taken by DispatchPosted is handed to the recorder before coalescing, nullptr detaches
+        AJ_INLINE void SetRecorder(EventRecorder* eventRecorder)
+        {
+            recorder = eventRecorder;
+        }
+
+        // number of finished DispatchPosted calls, the frame index recordings use
+        [[nodiscard]] AJ_INLINE u64 DispatchFrame() const
+        {
+            return dispatchFrame;
+        }
+
+        // fires everything posted before the call in post order, returns the number of dispatched events.
+        // Coalesced codes go to raw listeners right away and are merged for everyone else, the merged events
+        // fire once at the end of the batch (in order of their first occurrence, stamped with the last post)
+        u64 DispatchPosted();
+
+        // opt-in per code, nullptr turns it off again. Only affects posted events, FireEvent stays immediate
+        void SetCoalescing(EventCode eventCode, CoalesceFunction coalesce);
+
+        // post time of the event being dispatched, now for direct FireEvent calls
+        [[nodiscard]] AJ_INLINE u64 CurrentEventTimeNs() const
+        {
+            return currentEventTimeNs ? currentEventTimeNs : EventTimestampNow();
+        }
+
+        [[nodiscard]] u64 PendingPosted() const;
+
+        [[nodiscard]] u64 ListenerCount(EventCode eventCode) const;
+
     private:
-        std::vector<std::weak_ptr<IListener>> registered[MAX_MESSAGE_CODES];
+        using Thunk = bool (*)(void* instance, const void* callback, AJ_EVENT_PARAMETERS);
 
+        // member function pointers are up to 3 words (msvc, virtual inheritance)
+        static constexpr u64 CallbackStorage = 3 * sizeof(void*);
+
+        struct Entry
+        {
+            void* instance;
+            Thunk thunk; // nullptr: removed while dispatching, compacted afterwards
+            u32 slot;
+            bool raw;
+            alignas(void*) u8 callback[CallbackStorage];
+        };
+
+        struct DispatchList
+        {
+            std::vector<Entry> entries;
+            bool dirty = false;
+        };
+
+        struct Slot
+        {
+            u32 generation = 1;
+            u16 list = 0;
+            u32 position = 0;
+        };
+
+        std::vector<u16> lookup; // event code -> index into lists + 1, only as long as the highest used code
+        std::vector<DispatchList> lists;
+        std::vector<Slot> slots;
+        std::vector<u32> freeSlots;
+        u32 dispatchDepth = 0;
+        bool compactPending = false;
+        u64 currentEventTimeNs = 0;
+
+        enum class Receivers : u8
+        {
+            All,
+            Raw,
+            Merged,
+        };
+
+        std::vector<CoalesceFunction> coalescing; // by event code, only as long as the highest coalesced code
+        std::vector<u32> mergedIndex; // by event code -> index into merged + 1, only valid during DispatchPosted
+        std::vector<PostedEvent> merged;
+
+        std::atomic<bool> liveInput{true};
+        EventRecorder* recorder = nullptr;
+        u64 dispatchFrame = 0;
+
+        MpmcQueue<PostedEvent> posted;
+        std::atomic<u64> overflowCount{0};
+        mutable std::mutex overflowMutex;
+        std::deque<PostedEvent> overflow;
+
+        bool Dispatch(EventCode eventCode, void* sender, const EventContext& context,
+                      Receivers receivers = Receivers::All);
+
+        bool TryTakePosted(PostedEvent& event);
 
         template <typename D, typename R>
-        bool Remove(EventCode eventCode, Listener<D, R>* listener)
+        static bool Invoke(void* instance, const void* storage, AJ_EVENT_PARAMETERS)
         {
-            for (auto it = registered[eventCode].begin(); it != registered[eventCode].end(); ++it)
+            static_assert(std::is_same_v<R, bool> || std::is_same_v<R, void>,
+                          "Return type must be bool or void.");
+            using Callback = R (D::*)(AJ_EVENT_PARAMETERS);
+            Callback callback;
+            std::memcpy(&callback, storage, sizeof(Callback));
+            if constexpr (std::is_same_v<R, bool>)
+            {
+                return (static_cast<D*>(instance)->*callback)(AJ_EVENT_PARAMETERS_CALL);
+            }
+            else
             {
-                if (it->expired())
-                {
-                    registered[eventCode].erase(it);
-                    return true;
-                }
-                else
-                {
-                    if (it->lock().get() == listener)
-                    {
-                        registered[eventCode].erase(it);
-                        return true;
-                    }
-                }
+                (static_cast<D*>(instance)->*callback)(AJ_EVENT_PARAMETERS_CALL);
+                return false;
             }
-            return false;
         }
 
-        template <typename D, typename R>
-        Ref<Listener<D, R>> Add(EventCode eventCode, D* instance, Listener<D, R>::Callback callback)
-        {
-            std::shared_ptr<Listener<D, R>> listener(new Listener<D, R>(instance, callback),
-                                                     [this, eventCode](Listener<D, R>* pi)
-                                                     {
-                                                         PLOG_DEBUG << "Listener " << pi << " unregistered!";
-                                                         this->Remove<D, R>(eventCode, pi);
-                                                         delete pi;
-                                                     });
-            registered[eventCode].push_back(listener);
-            return listener;
-        }
+        ListenerHandle Add(EventCode eventCode, void* instance, Thunk thunk, const void* callback, u64 callbackSize,
+                           bool raw = false);
+
+        void Compact(DispatchList& list);
     };
 }
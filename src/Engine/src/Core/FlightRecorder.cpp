@@ -0,0 +1,171 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#include "FlightRecorder.h"
+#include "Core/Logger.h"
+
+#include <bit>
+#include <mutex>
+#include <vector>
+
+#ifdef AJ_PLATFORM_WINDOWS
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace Ajiva::Core
+{
+    // every site of the process, a new recording starts with all of them
+    static std::mutex siteMutex;
+    static std::vector<FlightSite> registeredSites;
+    static FlightRecorder* openRecorder = nullptr; // owned, guarded by siteMutex
+
+    static void CopyString(char* destination, u64 capacity, const std::string_view& text, bool keepTail)
+    {
+        const u64 count = std::min<u64>(text.size(), capacity - 1);
+        std::memcpy(destination, text.data() + (keepTail ? text.size() - count : 0), count);
+        destination[count] = 0;
+    }
+
+    bool FlightRecorder::Open(const std::filesystem::path& path, u32 slotCount)
+    {
+        Close();
+
+        std::lock_guard<std::mutex> lock(siteMutex);
+        auto* recorder = new FlightRecorder();
+        if (!recorder->Map(path, std::bit_ceil(std::max(slotCount, 2u))))
+        {
+            delete recorder;
+            return false;
+        }
+        for (u32 i = 0; i < registeredSites.size(); ++i)
+            recorder->PublishSite(i, registeredSites[i]);
+        openRecorder = recorder;
+        active.store(recorder, std::memory_order_release);
+        PLOG_INFO << "FlightRecorder: recording to " << path << " (" << recorder->header->SlotCount << " slots)";
+        return true;
+    }
+
+    void FlightRecorder::Close()
+    {
+        std::lock_guard<std::mutex> lock(siteMutex);
+        if (!openRecorder) return;
+        active.store(nullptr, std::memory_order_release);
+        PLOG_INFO << "FlightRecorder: closed " << openRecorder->path << " after " << openRecorder->RecordCount()
+            << " records";
+        delete openRecorder;
+        openRecorder = nullptr;
+    }
+
+    u32 FlightRecorder::AddSite(plog::Severity severity, const char* file, u32 line, const char* func,
+                                const char* format)
+    {
+        FlightSite site = {};
+        site.Severity = severity;
+        site.Line = line;
+        CopyString(site.File, sizeof(site.File), file, true);
+        CopyString(site.Func, sizeof(site.Func), plog::util::processFuncName(func), false);
+        CopyString(site.Format, sizeof(site.Format), format, false);
+
+        std::lock_guard<std::mutex> lock(siteMutex);
+        const u32 id = static_cast<u32>(registeredSites.size());
+        registeredSites.push_back(site);
+        if (openRecorder)
+            openRecorder->PublishSite(id, site);
+        return id;
+    }
+
+    void FlightRecorder::PublishSite(u32 id, const FlightSite& site)
+    {
+        if (id >= SiteCapacity)
+        {
+            if (id == SiteCapacity)
+            {
+                PLOG_WARNING << "FlightRecorder: more than " << SiteCapacity << " sites, later ones decode as unknown";
+            }
+            return;
+        }
+        sites[id] = site;
+        std::atomic_ref(header->SiteCount).store(id + 1, std::memory_order_release);
+    }
+
+    bool FlightRecorder::Map(const std::filesystem::path& path, u32 slotCount)
+    {
+        this->path = path;
+        mappingBytes = sizeof(FlightHeader) + u64(SiteCapacity) * sizeof(FlightSite) + u64(slotCount) *
+            sizeof(FlightSlot);
+#ifdef AJ_PLATFORM_WINDOWS
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS,
+                                  FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            PLOG_ERROR << "FlightRecorder: could not create " << path;
+            return false;
+        }
+        fileHandle = file;
+        mappingHandle = CreateFileMappingW(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(mappingBytes >> 32),
+                                           static_cast<DWORD>(mappingBytes), nullptr);
+        if (mappingHandle)
+            mapping = MapViewOfFile(mappingHandle, FILE_MAP_ALL_ACCESS, 0, 0, mappingBytes);
+#else
+        fileDescriptor = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fileDescriptor < 0)
+        {
+            PLOG_ERROR << "FlightRecorder: could not create " << path;
+            return false;
+        }
+        if (::ftruncate(fileDescriptor, static_cast<off_t>(mappingBytes)) == 0)
+        {
+            mapping = ::mmap(nullptr, mappingBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+            if (mapping == MAP_FAILED) mapping = nullptr;
+        }
+#endif
+        if (!mapping)
+        {
+            PLOG_ERROR << "FlightRecorder: could not map " << mappingBytes << " bytes of " << path;
+            return false;
+        }
+
+        // a fresh file reads as zeros, every slot starts out empty
+        header = new(mapping) FlightHeader();
+        header->SlotSize = sizeof(FlightSlot);
+        header->SlotCount = slotCount;
+        header->SiteSize = sizeof(FlightSite);
+        header->SiteCapacity = SiteCapacity;
+        header->StartNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        startNs = NowNs();
+        sites = reinterpret_cast<FlightSite*>(static_cast<u8*>(mapping) + sizeof(FlightHeader));
+        slots = reinterpret_cast<FlightSlot*>(sites + SiteCapacity);
+        slotMask = slotCount - 1;
+        return true;
+    }
+
+    FlightRecorder::~FlightRecorder()
+    {
+        // the OS writes the pages back on its own, also when the process dies, this only makes Close synchronous
+#ifdef AJ_PLATFORM_WINDOWS
+        if (mapping)
+        {
+            FlushViewOfFile(mapping, 0);
+            UnmapViewOfFile(mapping);
+        }
+        if (mappingHandle) CloseHandle(mappingHandle);
+        if (fileHandle) CloseHandle(fileHandle);
+#else
+        if (mapping)
+        {
+            ::msync(mapping, mappingBytes, MS_SYNC);
+            ::munmap(mapping, mappingBytes);
+        }
+        if (fileDescriptor >= 0) ::close(fileDescriptor);
+#endif
+    }
+} // Ajiva
+// Core
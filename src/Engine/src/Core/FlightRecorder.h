@@ -0,0 +1,277 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#pragma once
+
+#include "defines.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// 0 compiles every AJ_FLIGHT* macro to nothing
+#ifndef AJ_FLIGHT_RECORDING
+#define AJ_FLIGHT_RECORDING 1
+#endif
+
+// records the ring holds before it wraps, 128 bytes each
+#ifndef AJ_FLIGHT_RECORDER_SLOTS
+#define AJ_FLIGHT_RECORDER_SLOTS 65536
+#endif
+
+namespace Ajiva::Core
+{
+    // On disk: FlightHeader, SiteCapacity FlightSites, SlotCount FlightSlots, host byte order. The file is the
+    // mapping itself, whatever a crashed process wrote is still in it. Decode with Tools/FlightDecoder.
+    struct alignas(64) FlightHeader
+    {
+        char Magic[4] = {'A', 'J', 'F', 'R'};
+        u32 Version = 1;
+        u32 SlotSize = 0;
+        u32 SlotCount = 0;
+        u32 SiteSize = 0;
+        u32 SiteCapacity = 0;
+        u32 SiteCount = 0; // atomic
+        u32 Reserved = 0;
+        u64 StartNs = 0; // system clock, nanoseconds since the epoch, slot times are relative to it
+        u64 Cursor = 0; // atomic, sequence of the next record
+    };
+
+    // a format site, one per AJ_FLIGHT line. strings are cut to fit, File keeps its tail
+    struct FlightSite
+    {
+        u32 Severity;
+        u32 Line;
+        char File[120];
+        char Func[120];
+        char Format[256];
+        u64 Reserved;
+    };
+
+    // Data holds the arguments, each a FlightArg tag followed by its value. strings are a u8 length and the bytes
+    struct FlightSlot
+    {
+        u64 Sequence; // atomic, sequence + 1 once the slot is complete, 0 while it is written
+        u64 TimeNs;
+        u32 Site;
+        u32 Tid;
+        u8 Size;
+        u8 Flags;
+        u8 Data[102];
+    };
+
+    static_assert(sizeof(FlightHeader) == 64);
+    static_assert(sizeof(FlightSite) == 512);
+    static_assert(sizeof(FlightSlot) == 128);
+
+    enum class FlightArg : u8
+    {
+        Int = 'i', // i64
+        UInt = 'u', // u64
+        Float = 'f', // f64
+        Bool = 'b', // u8
+        Char = 'c', // u8
+        Pointer = 'p', // u64
+        String = 's', // u8 length + bytes
+    };
+
+    // the arguments did not fit, the last string is cut and later ones are missing
+    static constexpr u8 FlightSlotTruncated = 1;
+
+    namespace FlightEncoding
+    {
+        template <typename T>
+        AJ_INLINE bool Put(u8*& out, const u8* end, FlightArg tag, T value)
+        {
+            if (end - out < static_cast<std::ptrdiff_t>(1 + sizeof(T))) return false;
+            *out++ = static_cast<u8>(tag);
+            std::memcpy(out, &value, sizeof(T));
+            out += sizeof(T);
+            return true;
+        }
+
+        template <typename CharT>
+        AJ_INLINE bool PutString(u8*& out, const u8* end, const CharT* text, u64 length)
+        {
+            if (end - out < 2) return false;
+            const u64 space = std::min<u64>(end - out - 2, 255);
+            const u64 count = std::min(length, space);
+            *out++ = static_cast<u8>(FlightArg::String);
+            *out++ = static_cast<u8>(count);
+            if constexpr (sizeof(CharT) == 1)
+            {
+                std::memcpy(out, text, count);
+                out += count;
+            }
+            else
+            {
+                // wide paths on windows, only ascii survives
+                for (u64 i = 0; i < count; ++i)
+                    *out++ = text[i] < 0x80 ? static_cast<u8>(text[i]) : '?';
+            }
+            return count == length;
+        }
+
+        template <typename T>
+        AJ_INLINE bool Encode(u8*& out, const u8* end, const T& value)
+        {
+            using V = std::decay_t<T>;
+            if constexpr (std::is_same_v<V, bool>)
+                return Put(out, end, FlightArg::Bool, static_cast<u8>(value));
+            else if constexpr (std::is_same_v<V, char>)
+                return Put(out, end, FlightArg::Char, static_cast<u8>(value));
+            else if constexpr (std::is_enum_v<V>)
+                return Encode(out, end, static_cast<std::underlying_type_t<V>>(value));
+            else if constexpr (std::is_integral_v<V> && std::is_signed_v<V>)
+                return Put(out, end, FlightArg::Int, static_cast<i64>(value));
+            else if constexpr (std::is_integral_v<V>)
+                return Put(out, end, FlightArg::UInt, static_cast<u64>(value));
+            else if constexpr (std::is_floating_point_v<V>)
+                return Put(out, end, FlightArg::Float, static_cast<f64>(value));
+            else if constexpr (std::is_same_v<V, const char*> || std::is_same_v<V, char*>)
+                return value ? PutString(out, end, value, std::strlen(value)) : PutString(out, end, "null", 4);
+            else if constexpr (std::is_same_v<V, std::string> || std::is_same_v<V, std::string_view> ||
+                std::is_same_v<V, std::wstring> || std::is_same_v<V, std::wstring_view>)
+                return PutString(out, end, value.data(), value.size());
+            else if constexpr (std::is_same_v<V, std::filesystem::path>)
+                return PutString(out, end, value.native().data(), value.native().size());
+            else if constexpr (std::is_pointer_v<V>)
+                return Put(out, end, FlightArg::Pointer, reinterpret_cast<u64>(value));
+            else
+                static_assert(sizeof(V) == 0, "type can not be flight recorded, pass a number or a string");
+        }
+    }
+
+    // Binary log for always on tracing. A record is a format site id, a timestamp, the thread id and the raw
+    // arguments in a fixed size slot of a memory mapped ring, formatting happens offline in the decoder. Writers
+    // only share an atomic cursor.
+    class AJ_API FlightRecorder
+    {
+    public:
+        static constexpr u32 SiteCapacity = 1024;
+
+        // maps a new recording at path (replacing the file) and makes it the process wide recorder
+        static bool Open(const std::filesystem::path& path, u32 slotCount = AJ_FLIGHT_RECORDER_SLOTS);
+
+        // unmaps the recording, no other thread may be inside Write anymore
+        static void Close();
+
+        [[nodiscard]] static FlightRecorder* Active()
+        {
+            return active.load(std::memory_order_acquire);
+        }
+
+        // once per call site, ids stay valid across Open/Close. the arguments only drive AJ_FLIGHT
+        template <typename... Args>
+        static u32 RegisterSite(plog::Severity severity, const char* file, u32 line, const char* func,
+                                const char* format, const Args&...)
+        {
+            return AddSite(severity, file, line, func, format);
+        }
+
+        template <typename... Args>
+        void Write(u32 site, const char*, const Args&... args)
+        {
+            const u64 sequence = std::atomic_ref(header->Cursor).fetch_add(1, std::memory_order_relaxed);
+            FlightSlot& slot = slots[sequence & slotMask];
+            std::atomic_ref sequenceRef(slot.Sequence);
+            // a slot caught mid write reads as empty, also after a crash
+            sequenceRef.store(0, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            slot.TimeNs = NowNs() - startNs;
+            slot.Site = site;
+            slot.Tid = ThreadId();
+            u8* out = slot.Data;
+            const u8* end = slot.Data + sizeof(slot.Data);
+            const bool complete = (FlightEncoding::Encode(out, end, args) && ...);
+            slot.Size = static_cast<u8>(out - slot.Data);
+            slot.Flags = complete ? 0 : FlightSlotTruncated;
+
+            sequenceRef.store(sequence + 1, std::memory_order_release);
+        }
+
+        [[nodiscard]] u64 RecordCount() const
+        {
+            return std::atomic_ref(header->Cursor).load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] const std::filesystem::path& Path() const
+        {
+            return path;
+        }
+
+        ~FlightRecorder();
+
+        FlightRecorder(const FlightRecorder&) = delete;
+        FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    private:
+        static inline std::atomic<FlightRecorder*> active{nullptr};
+
+        std::filesystem::path path;
+        void* mapping = nullptr;
+        u64 mappingBytes = 0;
+        FlightHeader* header = nullptr;
+        FlightSite* sites = nullptr;
+        FlightSlot* slots = nullptr;
+        u64 slotMask = 0;
+        u64 startNs = 0; // steady clock at open
+#ifdef AJ_PLATFORM_WINDOWS
+        void* fileHandle = nullptr;
+        void* mappingHandle = nullptr;
+#else
+        int fileDescriptor = -1;
+#endif
+
+        FlightRecorder() = default;
+
+        bool Map(const std::filesystem::path& path, u32 slotCount);
+
+        void PublishSite(u32 id, const FlightSite& site);
+
+        static u32 AddSite(plog::Severity severity, const char* file, u32 line, const char* func, const char* format);
+
+        static AJ_INLINE u64 NowNs()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        static AJ_INLINE u32 ThreadId()
+        {
+            // plog asks the kernel every time on linux
+            thread_local const u32 tid = plog::util::gettid();
+            return tid;
+        }
+    };
+} // Ajiva
+// Core
+
+#if AJ_FLIGHT_RECORDING
+// AJ_FLIGHT(plog::debug, "loaded {} in {} ms", path, ms), "{}" is replaced by the next argument when decoding.
+// arguments are numbers, enums, pointers or strings, nothing is evaluated while no recorder is open
+#define AJ_FLIGHT(severity, ...)                                                                                  \
+    do                                                                                                            \
+    {                                                                                                             \
+        if (auto* ajFlightRecorder = ::Ajiva::Core::FlightRecorder::Active())                                     \
+        {                                                                                                         \
+            static const u32 ajFlightSite = ::Ajiva::Core::FlightRecorder::RegisterSite(                          \
+                severity, __FILE__, __LINE__, PLOG_GET_FUNC(), __VA_ARGS__);                                      \
+            ajFlightRecorder->Write(ajFlightSite, __VA_ARGS__);                                                   \
+        }                                                                                                         \
+    } while (0)
+#else
+#define AJ_FLIGHT(severity, ...) ((void)0)
+#endif
+
+#define AJ_FLIGHT_DEBUG(...) AJ_FLIGHT(plog::debug, __VA_ARGS__)
+#define AJ_FLIGHT_INFO(...) AJ_FLIGHT(plog::info, __VA_ARGS__)
+#define AJ_FLIGHT_WARNING(...) AJ_FLIGHT(plog::warning, __VA_ARGS__)
+#define AJ_FLIGHT_ERROR(...) AJ_FLIGHT(plog::error, __VA_ARGS__)
@@ -0,0 +1,88 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#include "FrameScheduler.h"
+#include "Core/Logger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace Ajiva::Core
+{
+    FrameScheduler::FrameScheduler(FrameSchedulerConfig config) : config(config),
+                                                                  step(1.0 / std::max(config.UpdateHz, 1.0))
+    {
+    }
+
+    void FrameScheduler::Start()
+    {
+        clock.Reset();
+        nextFrame = Clock::ClockType::now();
+        accumulator = 0.0;
+        simulated = 0.0;
+        dropped = 0.0;
+        updates = 0;
+    }
+
+    void FrameScheduler::BeginFrame()
+    {
+        clock.Update();
+        frameDelta = config.FixedFrameDelta > 0.0
+                         ? config.FixedFrameDelta
+                         : std::chrono::duration<f64>(clock.Delta()).count();
+        accumulator += std::min(frameDelta, config.MaxFrameDelta);
+        stepsThisFrame = 0;
+    }
+
+    bool FrameScheduler::Step(UpdateInfo& info)
+    {
+        if (accumulator < step)
+            return false;
+        if (stepsThisFrame >= config.MaxStepsPerFrame)
+        {
+            // keep the fraction so Alpha stays continuous, drop the whole steps we cannot afford
+            const f64 behind = accumulator - std::fmod(accumulator, step);
+            dropped += behind;
+            accumulator -= behind;
+            PLOG_DEBUG << "FrameScheduler dropped " << behind * 1000.0 << "ms of simulation";
+            return false;
+        }
+        accumulator -= step;
+        simulated += step;
+        ++stepsThisFrame;
+        info = {++updates, step, simulated};
+        return true;
+    }
+
+    UpdateInfo FrameScheduler::RenderInfo() const
+    {
+        return {clock.Ticks(), frameDelta, simulated + accumulator, Alpha()};
+    }
+
+    void FrameScheduler::EndFrame()
+    {
+        if (config.TargetFps <= 0.0)
+            return;
+
+        using namespace std::chrono;
+        const auto period = duration_cast<Clock::Duration>(duration<f64>(1.0 / config.TargetFps));
+        nextFrame += period;
+        auto now = Clock::ClockType::now();
+        if (nextFrame <= now)
+        {
+            // missed the deadline, restart the pacing from here instead of rushing the following frames
+            nextFrame = now;
+            return;
+        }
+
+        // the os sleep overshoots by up to a scheduler tick, the last part is spun
+        const auto spin = microseconds(config.SpinUs);
+        if (nextFrame - now > spin)
+            std::this_thread::sleep_for(nextFrame - now - spin);
+        while (Clock::ClockType::now() < nextFrame)
+            std::this_thread::yield();
+    }
+} // Ajiva
+// Core
@@ -0,0 +1,99 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#pragma once
+
+#include "defines.h"
+#include "Core/Clock.h"
+#include "Core/Layer.h"
+
+namespace Ajiva::Core
+{
+    struct FrameSchedulerConfig
+    {
+        f64 UpdateHz = 60.0;
+        // catch up limit, time that would need more steps is dropped so a hitch cannot spiral
+        u32 MaxStepsPerFrame = 5;
+        // longer frames (debugger, window drag) count as this much
+        f64 MaxFrameDelta = 0.25;
+        // 0: no limit, present (vsync) paces the loop
+        f64 TargetFps = 0.0;
+        // the limiter sleeps until this close to the deadline and spins for the rest
+        u32 SpinUs = 1500;
+        // > 0: every frame advances the simulation by this much instead of the measured time, replays use it to
+        // run the same steps on every machine
+        f64 FixedFrameDelta = 0.0;
+    };
+
+    // Fixed timestep loop on top of Clock:
+    //   scheduler.BeginFrame();
+    //   while (scheduler.Step(info)) Update(info);
+    //   Render(scheduler.RenderInfo());
+    //   scheduler.EndFrame();
+    // Simulation cost per simulated second stays the same at any display rate, rendering interpolates with Alpha.
+    class AJ_API FrameScheduler
+    {
+    public:
+        explicit FrameScheduler(FrameSchedulerConfig config = {});
+
+        void Start();
+
+        // measures the last frame and adds it to the accumulator
+        void BeginFrame();
+
+        // consumes one fixed step if enough time is accumulated, fills info for the update
+        bool Step(UpdateInfo& info);
+
+        // TotalTime is interpolated like Alpha
+        [[nodiscard]] UpdateInfo RenderInfo() const;
+
+        // see FrameSchedulerConfig::FixedFrameDelta, 0 measures the clock again
+        void SetFixedFrameDelta(f64 seconds)
+        {
+            config.FixedFrameDelta = seconds;
+        }
+
+        // waits for the frame limit if there is one
+        void EndFrame();
+
+        [[nodiscard]] f64 StepSeconds() const
+        {
+            return step;
+        }
+
+        [[nodiscard]] f64 Alpha() const
+        {
+            return accumulator / step;
+        }
+
+        [[nodiscard]] u64 UpdateCount() const
+        {
+            return updates;
+        }
+
+        // simulated time lost to the catch up limit
+        [[nodiscard]] f64 DroppedSeconds() const
+        {
+            return dropped;
+        }
+
+        [[nodiscard]] const Clock& FrameClock() const
+        {
+            return clock;
+        }
+
+    private:
+        FrameSchedulerConfig config;
+        Clock clock;
+        Clock::TimePoint nextFrame{};
+        f64 step;
+        f64 accumulator = 0.0;
+        f64 frameDelta = 0.0;
+        f64 simulated = 0.0;
+        f64 dropped = 0.0;
+        u64 updates = 0;
+        u32 stepsThisFrame = 0;
+    };
+} // Ajiva
+// Core
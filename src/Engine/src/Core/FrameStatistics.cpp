@@ -0,0 +1,127 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#include "FrameStatistics.h"
+#include "Core/Logger.h"
+
+#include <algorithm>
+#include <fstream>
+
+namespace Ajiva::Core
+{
+    FrameStatistics::FrameStatistics(FrameStatisticsConfig config) : config(config)
+    {
+        this->config.WindowFrames = std::max(this->config.WindowFrames, 1u);
+        window.reserve(this->config.WindowFrames);
+    }
+
+    void FrameStatistics::Record(const Clock& clock)
+    {
+        const f64 frameMs = std::chrono::duration<f64, std::milli>(clock.Delta()).count();
+        const f64 endMs = std::chrono::duration<f64, std::milli>(clock.Total()).count();
+        Record(frameMs, endMs - frameMs);
+    }
+
+    void FrameStatistics::Record(f64 frameMs, f64 startMs)
+    {
+        if (frameMs <= 0) return;
+
+        if (window.size() < config.WindowFrames)
+            window.push_back(static_cast<f32>(frameMs));
+        else
+            window[next] = static_cast<f32>(frameMs);
+        next = (next + 1) % config.WindowFrames;
+
+        const u64 ns = static_cast<u64>(frameMs * 1e6);
+        ++session.Buckets[AtomicLogHistogram::BucketOf(ns)];
+        ++session.Count;
+        session.SumNs += ns;
+        session.MaxNs = std::max(session.MaxNs, ns);
+        if (frameMs > config.HitchMs) ++hitches;
+
+        if (history.size() < config.MaxRecordedFrames)
+        {
+            history.push_back({startMs, static_cast<f32>(frameMs)});
+            if (history.size() == config.MaxRecordedFrames)
+            {
+                PLOG_WARNING << "FrameStatistics: history full, later frames only go into the window";
+            }
+        }
+        ++frames;
+    }
+
+    const FrameTimeSummary& FrameStatistics::Summary() const
+    {
+        if (summaryFrames == frames) return summary;
+        summaryFrames = frames;
+
+        summary = {};
+        if (window.empty()) return summary;
+        sorted.assign(window.begin(), window.end());
+        std::sort(sorted.begin(), sorted.end());
+
+        // nearest rank, exact over the window
+        const auto rank = [this](f64 p)
+        {
+            const u64 index = static_cast<u64>(p * static_cast<f64>(sorted.size() - 1) + 0.5);
+            return static_cast<f64>(sorted[index]);
+        };
+        f64 sum = 0;
+        for (const f32 ms : sorted)
+        {
+            sum += ms;
+            if (ms > config.HitchMs) ++summary.Hitches;
+        }
+        summary.Frames = sorted.size();
+        summary.AverageMs = sum / static_cast<f64>(sorted.size());
+        summary.P50Ms = rank(0.5);
+        summary.P90Ms = rank(0.9);
+        summary.P99Ms = rank(0.99);
+        summary.MaxMs = sorted.back();
+        return summary;
+    }
+
+    bool FrameStatistics::WriteCsv(const std::filesystem::path& path) const
+    {
+        std::ofstream out(path, std::ios::trunc);
+        if (!out.is_open())
+        {
+            PLOG_ERROR << "FrameStatistics: failed to open " << path;
+            return false;
+        }
+        out << "frame,start_ms,frame_ms,hitch\n";
+        out.setf(std::ios::fixed);
+        out.precision(4);
+        for (u64 i = 0; i < history.size(); ++i)
+        {
+            const auto& sample = history[i];
+            out << i << ',' << sample.StartMs << ',' << sample.FrameMs << ','
+                << (sample.FrameMs > config.HitchMs ? 1 : 0) << '\n';
+        }
+        PLOG_INFO << "FrameStatistics: wrote " << history.size() << " frames to " << path;
+        return true;
+    }
+
+    bool FrameStatistics::WriteHistogramCsv(const std::filesystem::path& path) const
+    {
+        std::ofstream out(path, std::ios::trunc);
+        if (!out.is_open())
+        {
+            PLOG_ERROR << "FrameStatistics: failed to open " << path;
+            return false;
+        }
+        out << "lower_ms,upper_ms,count\n";
+        out.setf(std::ios::fixed);
+        out.precision(6);
+        for (u64 i = 0; i < HistogramSnapshot::BucketCount; ++i)
+        {
+            if (!session.Buckets[i]) continue;
+            const f64 lower = i ? static_cast<f64>(u64(1) << i) / 1e6 : 0.0;
+            const f64 upper = static_cast<f64>(u64(1) << (i + 1)) / 1e6;
+            out << lower << ',' << upper << ',' << session.Buckets[i] << '\n';
+        }
+        return true;
+    }
+} // Ajiva
+// Core
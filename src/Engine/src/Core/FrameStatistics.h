@@ -0,0 +1,101 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#pragma once
+
+#include "defines.h"
+#include "Core/Clock.h"
+#include "Core/Histogram.h"
+
+#include <filesystem>
+#include <vector>
+
+namespace Ajiva::Core
+{
+    struct FrameStatisticsConfig
+    {
+        u32 WindowFrames = 600; // percentiles and the sparkline cover this many frames
+        f64 HitchMs = 33.3; // frames longer than this count as hitches
+        u64 MaxRecordedFrames = 1 << 20; // per frame history kept for the csv, ~4.8h at 60 fps
+    };
+
+    struct FrameTimeSummary
+    {
+        u64 Frames = 0; // in the window
+        u64 Hitches = 0; // in the window
+        f64 AverageMs = 0;
+        f64 P50Ms = 0;
+        f64 P90Ms = 0;
+        f64 P99Ms = 0;
+        f64 MaxMs = 0;
+    };
+
+    // CPU frame times: exact percentiles over a rolling window, a log2 histogram and the per frame history of the
+    // whole session. Main thread only.
+    class AJ_API FrameStatistics
+    {
+    public:
+        explicit FrameStatistics(FrameStatisticsConfig config = {});
+
+        // the frame the clock measured in its last Update
+        void Record(const Clock& clock);
+
+        void Record(f64 frameMs, f64 startMs);
+
+        // sorted once per recorded frame, repeated calls are free
+        [[nodiscard]] const FrameTimeSummary& Summary() const;
+
+        // ring of the last WindowFrames frame times in ms, oldest at WindowOffset (for ImGui::PlotLines)
+        [[nodiscard]] const std::vector<f32>& Window() const
+        {
+            return window;
+        }
+
+        [[nodiscard]] u64 WindowOffset() const
+        {
+            return window.size() < config.WindowFrames ? 0 : next;
+        }
+
+        [[nodiscard]] const HistogramSnapshot& SessionHistogram() const
+        {
+            return session;
+        }
+
+        [[nodiscard]] u64 SessionHitches() const
+        {
+            return hitches;
+        }
+
+        [[nodiscard]] const FrameStatisticsConfig& GetConfig() const
+        {
+            return config;
+        }
+
+        // frame,start_ms,frame_ms,hitch
+        bool WriteCsv(const std::filesystem::path& path) const;
+
+        // lower_ms,upper_ms,count over the session histogram
+        bool WriteHistogramCsv(const std::filesystem::path& path) const;
+
+    private:
+        struct FrameSample
+        {
+            f64 StartMs;
+            f32 FrameMs;
+        };
+
+        FrameStatisticsConfig config;
+        std::vector<f32> window;
+        u64 next = 0;
+        HistogramSnapshot session;
+        u64 hitches = 0;
+        u64 frames = 0;
+        std::vector<FrameSample> history;
+
+        mutable FrameTimeSummary summary;
+        mutable u64 summaryFrames = 0;
+        mutable std::vector<f32> sorted;
+    };
+} // Ajiva
+// Core
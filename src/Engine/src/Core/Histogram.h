@@ -0,0 +1,106 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#pragma once
+
+#include "defines.h"
+
+#include <atomic>
+#include <bit>
+
+namespace Ajiva::Core
+{
+    // Plain copy of a histogram, bucket i counts samples in [2^i, 2^(i+1)) ns (bucket 0 also holds 0).
+    struct HistogramSnapshot
+    {
+        static constexpr u64 BucketCount = 40; // up to ~18 minutes
+
+        u64 Buckets[BucketCount] = {};
+        u64 Count = 0;
+        u64 SumNs = 0;
+        u64 MaxNs = 0;
+
+        void Merge(const HistogramSnapshot& other)
+        {
+            for (u64 i = 0; i < BucketCount; ++i)
+            {
+                Buckets[i] += other.Buckets[i];
+            }
+            Count += other.Count;
+            SumNs += other.SumNs;
+            MaxNs = MaxNs > other.MaxNs ? MaxNs : other.MaxNs;
+        }
+
+        [[nodiscard]] f64 AverageMs() const
+        {
+            return Count ? static_cast<f64>(SumNs) / static_cast<f64>(Count) / 1e6 : 0.0;
+        }
+
+        [[nodiscard]] f64 MaxMs() const
+        {
+            return static_cast<f64>(MaxNs) / 1e6;
+        }
+
+        // upper bound of the bucket that contains the percentile, p in [0, 1]
+        [[nodiscard]] f64 PercentileMs(f64 p) const
+        {
+            if (!Count) return 0.0;
+            const u64 target = static_cast<u64>(p * static_cast<f64>(Count - 1)) + 1;
+            u64 seen = 0;
+            for (u64 i = 0; i < BucketCount; ++i)
+            {
+                seen += Buckets[i];
+                if (seen >= target)
+                {
+                    const f64 upper = static_cast<f64>(u64(1) << (i + 1)) / 1e6;
+                    return upper < MaxMs() ? upper : MaxMs();
+                }
+            }
+            return MaxMs();
+        }
+    };
+
+    // Log2 histogram that can be recorded into from any thread, relaxed atomics only.
+    class AtomicLogHistogram
+    {
+    public:
+        AJ_INLINE void Record(u64 ns)
+        {
+            buckets[BucketOf(ns)].fetch_add(1, std::memory_order_relaxed);
+            count.fetch_add(1, std::memory_order_relaxed);
+            sum.fetch_add(ns, std::memory_order_relaxed);
+            u64 current = max.load(std::memory_order_relaxed);
+            while (ns > current && !max.compare_exchange_weak(current, ns, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        // not atomic as a whole, counts may be off by the samples recorded during the copy
+        [[nodiscard]] HistogramSnapshot Snapshot() const
+        {
+            HistogramSnapshot snapshot;
+            for (u64 i = 0; i < HistogramSnapshot::BucketCount; ++i)
+            {
+                snapshot.Buckets[i] = buckets[i].load(std::memory_order_relaxed);
+            }
+            snapshot.Count = count.load(std::memory_order_relaxed);
+            snapshot.SumNs = sum.load(std::memory_order_relaxed);
+            snapshot.MaxNs = max.load(std::memory_order_relaxed);
+            return snapshot;
+        }
+
+        static AJ_INLINE u64 BucketOf(u64 ns)
+        {
+            const u64 bucket = ns ? static_cast<u64>(std::bit_width(ns)) - 1 : 0;
+            return bucket < HistogramSnapshot::BucketCount ? bucket : HistogramSnapshot::BucketCount - 1;
+        }
+
+    private:
+        std::atomic<u64> buckets[HistogramSnapshot::BucketCount] = {};
+        std::atomic<u64> count{0};
+        std::atomic<u64> sum{0};
+        std::atomic<u64> max{0};
+    };
+} // Ajiva
+// Core
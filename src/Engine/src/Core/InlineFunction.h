@@ -0,0 +1,180 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#pragma once
+
+#include "defines.h"
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#ifndef AJ_TASK_INLINE_SIZE
+#define AJ_TASK_INLINE_SIZE 48
+#endif
+
+namespace Ajiva::Core
+{
+    template <typename Signature, u64 Capacity>
+    class InlineFunction;
+
+    // Move-only callable with a fixed inline buffer, a replacement for std::function on hot paths.
+    // Whether a callable fits is decided at compile time: small ones are stored in place, larger ones take the
+    // overflow path (one heap allocation). Define AJ_TASK_STRICT_INLINE to turn the overflow path into an error.
+    template <typename R, typename... Args, u64 Capacity>
+    class InlineFunction<R(Args...), Capacity>
+    {
+        struct Ops
+        {
+            R (*invoke)(void* storage, Args&&... args);
+            void (*move)(void* from, void* to) noexcept;
+            void (*destroy)(void* storage) noexcept;
+        };
+
+        template <typename F>
+        struct InlineOps
+        {
+            static R Invoke(void* storage, Args&&... args)
+            {
+                return (*static_cast<F*>(storage))(std::forward<Args>(args)...);
+            }
+
+            static void Move(void* from, void* to) noexcept
+            {
+                new(to) F(std::move(*static_cast<F*>(from)));
+                static_cast<F*>(from)->~F();
+            }
+
+            static void Destroy(void* storage) noexcept
+            {
+                static_cast<F*>(storage)->~F();
+            }
+
+            static constexpr Ops Table{Invoke, Move, Destroy};
+        };
+
+        template <typename F>
+        struct HeapOps
+        {
+            static R Invoke(void* storage, Args&&... args)
+            {
+                return (**static_cast<F**>(storage))(std::forward<Args>(args)...);
+            }
+
+            static void Move(void* from, void* to) noexcept
+            {
+                *static_cast<F**>(to) = *static_cast<F**>(from);
+            }
+
+            static void Destroy(void* storage) noexcept
+            {
+                delete *static_cast<F**>(storage);
+            }
+
+            static constexpr Ops Table{Invoke, Move, Destroy};
+        };
+
+    public:
+        template <typename F>
+        static constexpr bool FitsInline = sizeof(F) <= Capacity
+                                           && alignof(F) <= alignof(std::max_align_t)
+                                           && std::is_nothrow_move_constructible_v<F>;
+
+        InlineFunction() noexcept = default;
+
+        InlineFunction(std::nullptr_t) noexcept
+        {
+        }
+
+        template <typename F, typename Fn = std::decay_t<F>,
+            typename = std::enable_if_t<!std::is_same_v<Fn, InlineFunction> && std::is_invocable_r_v<R, Fn&, Args...>>>
+        InlineFunction(F&& func)
+        {
+            if constexpr (std::is_constructible_v<bool, const Fn&>)
+            {
+                // empty std::function or null function pointer
+                if (!static_cast<bool>(func)) return;
+            }
+            if constexpr (FitsInline<Fn>)
+            {
+                new(storage) Fn(std::forward<F>(func));
+                ops = &InlineOps<Fn>::Table;
+            }
+            else
+            {
+#ifdef AJ_TASK_STRICT_INLINE
+                static_assert(FitsInline<Fn>, "capture does not fit into the inline task storage");
+#endif
+                *reinterpret_cast<Fn**>(storage) = new Fn(std::forward<F>(func));
+                ops = &HeapOps<Fn>::Table;
+            }
+        }
+
+        InlineFunction(InlineFunction&& other) noexcept
+        {
+            MoveFrom(other);
+        }
+
+        InlineFunction& operator=(InlineFunction&& other) noexcept
+        {
+            if (this != &other)
+            {
+                Reset();
+                MoveFrom(other);
+            }
+            return *this;
+        }
+
+        InlineFunction& operator=(std::nullptr_t) noexcept
+        {
+            Reset();
+            return *this;
+        }
+
+        InlineFunction(const InlineFunction&) = delete;
+        InlineFunction& operator=(const InlineFunction&) = delete;
+
+        ~InlineFunction()
+        {
+            Reset();
+        }
+
+        R operator()(Args... args)
+        {
+            return ops->invoke(storage, std::forward<Args>(args)...);
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return ops != nullptr;
+        }
+
+        void Reset() noexcept
+        {
+            if (ops)
+            {
+                ops->destroy(storage);
+                ops = nullptr;
+            }
+        }
+
+    private:
+        void MoveFrom(InlineFunction& other) noexcept
+        {
+            if (other.ops)
+            {
+                other.ops->move(other.storage, storage);
+                ops = other.ops;
+                other.ops = nullptr;
+            }
+        }
+
+        alignas(std::max_align_t) std::byte storage[Capacity < sizeof(void*) ? sizeof(void*) : Capacity];
+        const Ops* ops = nullptr;
+    };
+
+    using TaskFunction = InlineFunction<void(), AJ_TASK_INLINE_SIZE>;
+} // Ajiva
+// Core
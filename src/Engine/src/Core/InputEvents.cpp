@@ -0,0 +1,48 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#include "InputEvents.h"
+
+namespace Ajiva::Core
+{
+    void InputChannels::Bridge(EventSystem& eventSystem)
+    {
+        bridged.clear();
+        bridged.push_back(eventSystem.Add(KeyDown, this, &InputChannels::OnKey));
+        bridged.push_back(eventSystem.Add(KeyUp, this, &InputChannels::OnKey));
+        bridged.push_back(eventSystem.Add(EventCode::MouseMove, this, &InputChannels::OnMouseMove));
+        bridged.push_back(eventSystem.Add(MouseButtonDown, this, &InputChannels::OnMouseButton));
+        bridged.push_back(eventSystem.Add(MouseButtonUp, this, &InputChannels::OnMouseButton));
+        bridged.push_back(eventSystem.Add(EventCode::MouseScroll, this, &InputChannels::OnMouseScroll));
+        bridged.push_back(eventSystem.Add(EventCode::FramebufferResize, this, &InputChannels::OnFramebufferResize));
+    }
+
+    bool InputChannels::OnKey(AJ_EVENT_PARAMETERS)
+    {
+        return Key.Publish({event.key.key, event.key.scancode, event.key.mods, code == KeyDown});
+    }
+
+    bool InputChannels::OnMouseMove(AJ_EVENT_PARAMETERS)
+    {
+        const auto& move = event.mouse.move;
+        return MouseMove.Publish({move.x, move.y, move.dx, move.dy});
+    }
+
+    bool InputChannels::OnMouseButton(AJ_EVENT_PARAMETERS)
+    {
+        const auto& click = event.mouse.click;
+        return MouseButton.Publish({click.x, click.y, click.button, click.mods, code == MouseButtonDown});
+    }
+
+    bool InputChannels::OnMouseScroll(AJ_EVENT_PARAMETERS)
+    {
+        return MouseScroll.Publish({event.mouse.wheel.xOffset, event.mouse.wheel.yOffset});
+    }
+
+    bool InputChannels::OnFramebufferResize(AJ_EVENT_PARAMETERS)
+    {
+        return FramebufferResize.Publish({event.framebufferSize.width, event.framebufferSize.height});
+    }
+} // Ajiva
+// Core
@@ -0,0 +1,77 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#pragma once
+
+#include "defines.h"
+#include "Core/EventChannel.h"
+#include "Core/EventSystem.h"
+
+namespace Ajiva::Core
+{
+    struct KeyEvent
+    {
+        i32 Key;
+        i32 Scancode;
+        i32 Mods;
+        bool Down;
+    };
+
+    struct MouseMoveEvent
+    {
+        i32 X;
+        i32 Y;
+        i32 DeltaX;
+        i32 DeltaY;
+    };
+
+    struct MouseButtonEvent
+    {
+        i32 X;
+        i32 Y;
+        i32 Button;
+        i32 Mods;
+        bool Down;
+    };
+
+    struct MouseScrollEvent
+    {
+        f64 OffsetX;
+        f64 OffsetY;
+    };
+
+    struct FramebufferResizeEvent
+    {
+        u32 Width;
+        u32 Height;
+    };
+
+    // Typed channels for the window input. The GLFW callbacks still produce EventCode events, Bridge subscribes to
+    // those (coalescing applies as for any other listener) and republishes them with their own struct type.
+    class AJ_API InputChannels
+    {
+    public:
+        EventChannel<KeyEvent> Key;
+        EventChannel<MouseMoveEvent> MouseMove;
+        EventChannel<MouseButtonEvent> MouseButton;
+        EventChannel<MouseScrollEvent> MouseScroll;
+        EventChannel<FramebufferResizeEvent> FramebufferResize;
+
+        void Bridge(EventSystem& eventSystem);
+
+    private:
+        std::vector<EventSubscription> bridged;
+
+        bool OnKey(AJ_EVENT_PARAMETERS);
+
+        bool OnMouseMove(AJ_EVENT_PARAMETERS);
+
+        bool OnMouseButton(AJ_EVENT_PARAMETERS);
+
+        bool OnMouseScroll(AJ_EVENT_PARAMETERS);
+
+        bool OnFramebufferResize(AJ_EVENT_PARAMETERS);
+    };
+} // Ajiva
+// Core
@@ -1,4 +1,16 @@
 //
 // Created by XuriAjiva on 15.08.2023.
 //
-#include "Layer.h"
\ No newline at end of file
+#include "Layer.h"
+#include "Core/Profiler.h"
+
+namespace Ajiva::Core
+{
+    const char* Layer::ProfileName() const
+    {
+        if (!profileName)
+            profileName = Profiler::Intern(name.empty() ? "Layer" : name);
+        return profileName;
+    }
+} // Ajiva
+// Core
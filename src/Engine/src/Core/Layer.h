@@ -15,6 +15,9 @@ namespace Ajiva::Core
         u64 FrameNumber;
         f64 FrameDelta;
         f64 TotalTime;
+        // render only: how far the frame is between the last and the next fixed update, 0..1. interpolate the
+        // simulated state with it, render info TotalTime already is
+        f64 Alpha = 1.0;
     };
 
     struct RenderTarget
@@ -69,6 +72,9 @@ namespace Ajiva::Core
             return name;
         }
 
+        // interned name for profiler scopes
+        [[nodiscard]] const char* ProfileName() const;
+
         [[nodiscard]] inline bool IsEnabled() const
         {
             return enabled;
@@ -76,6 +82,7 @@ namespace Ajiva::Core
 
     private:
         std::string name;
+        mutable const char* profileName = nullptr;
         bool enabled = true;
     };
 } // Ajiva
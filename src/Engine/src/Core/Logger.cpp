@@ -2,16 +2,29 @@
 // Created by XuriAjiva on 31.07.2023.
 //
 #include "Logger.h"
+#include "Core/AsyncAppender.h"
 
 #include <plog/Appenders/ColorConsoleAppender.h>
 #include <plog/Formatters/TxtFormatter.h>
 #include <plog/Init.h>
 
+#include <chrono>
+#include <exception>
+
 #ifdef AJ_LOG_IMGUI
 
 #include "imgui.h"
 #include "magic_enum.hpp"
-#include <list>
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifndef AJ_LOG_IMGUI_CAPACITY
+#define AJ_LOG_IMGUI_CAPACITY 16384
+#endif
 
 using namespace plog;
 
@@ -32,15 +45,60 @@ public:
     }
 };
 
-template <class Formatter> // Typically a formatter is passed as a template parameter.
-class ImGuiAppender : public IAppender // All appenders MUST inherit IAppender interface.
+// Keeps the newest AJ_LOG_IMGUI_CAPACITY records, formatted once when they are written. Any thread may write, the
+// records wait in a bounded pending list until the log window takes them over on the main thread. Every severity
+// has its own index, the visible rows are merged from the enabled ones and drawn through a list clipper.
+class ImGuiAppender : public IAppender
 {
+    struct Entry
+    {
+        u64 Sequence = 0;
+        Severity Level = none;
+        unsigned int Tid = 0;
+        char Time[16] = {};
+        std::string Location;
+        std::string File;
+        std::string Message; // first line only, the clipper needs rows of one line
+        std::string Full; // the whole message when it had more lines
+    };
+
 public:
-    void write(const Record& record) PLOG_OVERRIDE // This is a method from IAppender that MUST be implemented.
+    static constexpr u64 Capacity = AJ_LOG_IMGUI_CAPACITY;
+    static constexpr u64 SeverityCount = 7;
+
+    void write(const Record& record) PLOG_OVERRIDE
     {
-        m_messageList.push_back(record);
-    }
+        Entry entry;
+        entry.Level = record.getSeverity();
+        entry.Tid = record.getTid();
+        tm t{};
+        util::localtime_s(&t, &record.getTime().time);
+        snprintf(entry.Time, sizeof(entry.Time), "%02d:%02d:%02d.%03d", t.tm_hour, t.tm_min, t.tm_sec,
+                 static_cast<int>(record.getTime().millitm));
+        entry.Location = std::string(record.getFunc()) + "@" + std::to_string(record.getLine());
+        entry.File = std::string(record.getFile()) + ":" + std::to_string(record.getLine());
+#ifdef AJ_PLATFORM_WINDOWS
+        const std::wstring wide(record.getMessage());
+        entry.Message.assign(wide.begin(), wide.end());
+#else
+        entry.Message = record.getMessage();
+#endif
+        while (!entry.Message.empty() && (entry.Message.back() == '\n' || entry.Message.back() == '\r'))
+            entry.Message.pop_back();
+        if (const auto newline = entry.Message.find('\n'); newline != std::string::npos)
+        {
+            const auto lines = std::count(entry.Message.begin(), entry.Message.end(), '\n');
+            entry.Full = entry.Message;
+            entry.Message.resize(newline);
+            entry.Message.append(" [+").append(std::to_string(lines)).append(" lines]");
+        }
 
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        // nobody drew the log for a while, the oldest would fall out of the ring anyway
+        if (pending.size() >= Capacity)
+            pending.pop_front();
+        pending.push_back(std::move(entry));
+    }
 
     void Draw()
     {
@@ -54,6 +112,8 @@ public:
             {0.0f, 0.4f, 0.4f, 1.0f}, //verbose = 6
         };
 
+        TakePending();
+
         // Main window
         bool clear = ImGui::Button("Clear");
         ImGui::SameLine();
@@ -68,38 +128,53 @@ public:
             PLOG_ERROR << "This is an ERROR message";
             PLOG_FATAL << "This is a FATAL message";
         }
-
-        ImGui::Checkbox("None", &SeverityFilter[0]);
         ImGui::SameLine();
-        ImGui::Checkbox("Fatal", &SeverityFilter[1]);
-        ImGui::SameLine();
-        ImGui::Checkbox("Error", &SeverityFilter[2]);
-        ImGui::SameLine();
-        ImGui::Checkbox("Warning", &SeverityFilter[3]);
-        ImGui::SameLine();
-        ImGui::Checkbox("Info", &SeverityFilter[4]);
-        ImGui::SameLine();
-        ImGui::Checkbox("Debug", &SeverityFilter[5]);
-        ImGui::SameLine();
-        ImGui::Checkbox("Verbose", &SeverityFilter[6]);
+        ImGui::Text("%zu shown", visible.size());
+
+        static const char* SeverityNames[SeverityCount] = {
+            "None", "Fatal", "Error", "Warning", "Info", "Debug", "Verbose"
+        };
+        bool filterChanged = false;
+        for (u64 i = 0; i < SeverityCount; ++i)
+        {
+            if (i) ImGui::SameLine();
+            filterChanged |= ImGui::Checkbox(SeverityNames[i], &SeverityFilter[i]);
+        }
+        if (filterChanged)
+            RebuildVisible();
+
+        if (ImGui::TreeNode("Module thresholds"))
+        {
+            using Ajiva::Core::LogModule;
+            for (u8 i = 0; i < static_cast<u8>(LogModule::Count); ++i)
+            {
+                const auto module = static_cast<LogModule>(i);
+                int threshold = Ajiva::Core::LogThresholds[i].load(std::memory_order_relaxed);
+                ImGui::SetNextItemWidth(120);
+                if (ImGui::Combo(Ajiva::Core::LogModuleName(module), &threshold, SeverityNames, SeverityCount))
+                    Ajiva::Core::SetLogThreshold(module, static_cast<Severity>(threshold));
+            }
+            ImGui::TreePop();
+        }
+
+        if (clear)
+            Clear();
+        if (copy)
+            CopyVisible();
 
         ImGui::Separator();
 
         if (ImGui::BeginChild("scrolling", ImVec2(0, 0), false, ImGuiWindowFlags_HorizontalScrollbar))
         {
-            if (clear)
-                m_messageList.clear();
-            if (copy)
-                ImGui::LogToClipboard();
-
             ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(0, 0));
 
             if (ImGui::BeginTable("log", 6,
                                   ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable |
                                   ImGuiTableFlags_Reorderable | ImGuiTableFlags_Hideable |
-                                  ImGuiTableFlags_ScrollX |
+                                  ImGuiTableFlags_ScrollX | ImGuiTableFlags_ScrollY |
                                   ImGuiTableFlags_SizingStretchProp))
             {
+                ImGui::TableSetupScrollFreeze(0, 1);
                 ImGui::TableSetupColumn("Severity", ImGuiTableColumnFlags_WidthFixed, 56);
                 ImGui::TableSetupColumn("Time", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_DefaultSort,
                                         91);
@@ -113,66 +188,143 @@ public:
 
                 ImGui::TableHeadersRow();
 
-                for (auto& record : m_messageList)
+                // rows have one line each so the clipper can skip everything outside the view
+                ImGuiListClipper clipper;
+                clipper.Begin(static_cast<int>(visible.size()));
+                while (clipper.Step())
                 {
-                    auto severity = record.getSeverity();
-                    if (!SeverityFilter[severity]) continue;
-                    tm t{};
-                    util::localtime_s(&t, &record.getTime().time);
-
-                    ImColor color = Colors[severity];
-
-                    ImGui::TableNextRow();
-
-                    if (severity == Severity::fatal)
+                    for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
                     {
-                        ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 1.0f, 1.0f, 1.0f));
-                        ImGui::TableSetBgColor(ImGuiTableBgTarget_RowBg1, color);
+                        const auto& entry = ring[visible[row] % Capacity];
+                        ImColor color = Colors[entry.Level];
+
+                        ImGui::TableNextRow();
+
+                        if (entry.Level == Severity::fatal)
+                        {
+                            ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 1.0f, 1.0f, 1.0f));
+                            ImGui::TableSetBgColor(ImGuiTableBgTarget_RowBg1, color);
+                        }
+                        else
+                        {
+                            ImGui::PushStyleColor(ImGuiCol_Text, color.Value);
+                        }
+
+                        ImGui::TableNextColumn();
+                        ImGui::TextUnformatted(severityToString(entry.Level));
+                        ImGui::TableNextColumn();
+                        ImGui::TextUnformatted(entry.Time);
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%u", entry.Tid);
+                        ImGui::TableNextColumn();
+                        ImGui::TextUnformatted(entry.Location.c_str());
+                        ImGui::TableNextColumn();
+                        ImGui::TextUnformatted(entry.File.c_str());
+                        ImGui::TableNextColumn();
+                        ImGui::TextUnformatted(entry.Message.c_str());
+                        if (!entry.Full.empty() && ImGui::IsItemHovered())
+                            ImGui::SetTooltip("%s", entry.Full.c_str());
+                        ImGui::PopStyleColor();
                     }
-                    else
-                    {
-                        ImGui::PushStyleColor(ImGuiCol_Text, color.Value);
-                    }
-
-                    ImGui::TableNextColumn();
-                    ImGui::Text("%s", severityToString(record.getSeverity()));
-                    ImGui::TableNextColumn();
-                    ImGui::Text("%02d:%02d:%02d.%03d ", t.tm_hour, t.tm_min, t.tm_sec, record.getTime().millitm);
-                    ImGui::TableNextColumn();
-                    ImGui::Text("%d", record.getTid());
-                    ImGui::TableNextColumn();
-                    ImGui::TextWrapped("%s@%zu", record.getFunc(), record.getLine());
-                    ImGui::TableNextColumn();
-                    ImGui::TextWrapped("%s:%zu", record.getFile(), record.getLine());
-                    ImGui::TableNextColumn();
-#ifdef AJ_PLATFORM_WINDOWS
-                    std::wstring w_string(record.getMessage());
-                    std::string string(w_string.begin(), w_string.end());
-                    ImGui::TextWrapped("%s", string.c_str());
-#else
-                    ImGui::TextWrapped(record.getMessage());
-#endif
-                    ImGui::PopStyleColor();
-                    ImGui::TableNextColumn();
                 }
 
+                // follow new records while the view sits at the bottom
+                if (ImGui::GetScrollY() >= ImGui::GetScrollMaxY())
+                    ImGui::SetScrollHereY(1.0f);
+
                 ImGui::EndTable();
             }
 
             ImGui::PopStyleVar();
-
-            if (copy)
-                ImGui::LogFinish();
         }
         ImGui::EndChild();
     }
 
 private:
-    std::list<Record> m_messageList;
-    bool SeverityFilter[7] = {true, true, true, true, true, true, false};
+    std::mutex pendingMutex;
+    std::deque<Entry> pending;
+
+    // main thread only
+    std::vector<Entry> ring = std::vector<Entry>(Capacity);
+    u64 next = 0; // sequence of the next record
+    std::deque<u64> bySeverity[SeverityCount];
+    std::deque<u64> visible;
+    bool SeverityFilter[SeverityCount] = {true, true, true, true, true, true, false};
+
+    [[nodiscard]] u64 Oldest() const
+    {
+        return next > Capacity ? next - Capacity : 0;
+    }
+
+    void TakePending()
+    {
+        std::deque<Entry> taken;
+        {
+            std::lock_guard<std::mutex> lock(pendingMutex);
+            taken.swap(pending);
+        }
+        for (auto& entry : taken)
+        {
+            entry.Sequence = next++;
+            const u64 level = std::min<u64>(entry.Level, SeverityCount - 1);
+            bySeverity[level].push_back(entry.Sequence);
+            if (SeverityFilter[level])
+                visible.push_back(entry.Sequence);
+            ring[entry.Sequence % Capacity] = std::move(entry);
+        }
+
+        // drop the indices of records the ring overwrote
+        const u64 oldest = Oldest();
+        for (auto& index : bySeverity)
+        {
+            while (!index.empty() && index.front() < oldest)
+                index.pop_front();
+        }
+        while (!visible.empty() && visible.front() < oldest)
+            visible.pop_front();
+    }
+
+    void RebuildVisible()
+    {
+        // merge the enabled severities by sequence
+        visible.clear();
+        u64 cursor[SeverityCount] = {};
+        for (;;)
+        {
+            u64 best = SeverityCount;
+            for (u64 i = 0; i < SeverityCount; ++i)
+            {
+                if (!SeverityFilter[i] || cursor[i] >= bySeverity[i].size()) continue;
+                if (best == SeverityCount || bySeverity[i][cursor[i]] < bySeverity[best][cursor[best]])
+                    best = i;
+            }
+            if (best == SeverityCount) break;
+            visible.push_back(bySeverity[best][cursor[best]++]);
+        }
+    }
+
+    void Clear()
+    {
+        for (auto& index : bySeverity)
+            index.clear();
+        visible.clear();
+        // sequences keep counting, the ring slots are simply no longer referenced
+    }
+
+    void CopyVisible()
+    {
+        std::string text;
+        for (const u64 sequence : visible)
+        {
+            const auto& entry = ring[sequence % Capacity];
+            text.append(entry.Time).append(" ").append(severityToString(entry.Level)).append(" ")
+                .append(entry.Full.empty() ? entry.Message : entry.Full).append("\n");
+        }
+        ImGui::SetClipboardText(text.c_str());
+    }
 };
 
-static ImGuiAppender<plog::TxtFormatter> imgui_appender;
+static ImGuiAppender imgui_appender;
 
 void Ajiva::Core::ShowAppLog(bool* p_open)
 {
@@ -221,11 +373,26 @@ public:
 };
 
 static plog::ColorConsoleAppender<AjivaTxtFormatter> consoleAppender;
+static Ajiva::Scope<Ajiva::Core::AsyncAppender> asyncAppender;
+static std::terminate_handler previousTerminate = nullptr;
 
 
-void Ajiva::Core::SetupLogger()
+void Ajiva::Core::SetupLogger(const LoggerConfig& config)
 {
-    plog::init(plog::verbose, &consoleAppender)
+    plog::IAppender* console = &consoleAppender;
+    if (config.Async && !asyncAppender)
+    {
+        asyncAppender = CreateScope<AsyncAppender>(&consoleAppender, config.QueueCapacity, config.Overflow);
+        console = asyncAppender.get();
+        // an uncaught exception (AJ_FAIL) must not lose the records that explain it
+        previousTerminate = std::set_terminate([]()
+        {
+            FlushLogger();
+            if (previousTerminate) previousTerminate();
+            std::abort();
+        });
+    }
+    plog::init(plog::verbose, console)
 #ifdef AJ_LOG_IMGUI
         .addAppender(&imgui_appender)
 #endif
@@ -239,3 +406,103 @@ void Ajiva::Core::SetupLogger()
     PLOG_ERROR << "This is an ERROR message";
     PLOG_FATAL << "This is a FATAL message";
 }
+
+void Ajiva::Core::FlushLogger()
+{
+    if (asyncAppender) asyncAppender->Flush();
+}
+
+void Ajiva::Core::ShutdownLogger()
+{
+    ReportSuppressedLogs();
+    if (asyncAppender) asyncAppender->Shutdown();
+}
+
+void Ajiva::Core::SetLogThreshold(LogModule module, plog::Severity severity)
+{
+    LogThresholds[static_cast<u8>(module)].store(severity, std::memory_order_relaxed);
+}
+
+const char* Ajiva::Core::LogModuleName(LogModule module)
+{
+    static const char* Names[] = {"Core", "Renderer", "Resource", "Platform", "App"};
+    return module < LogModule::Count ? Names[static_cast<u8>(module)] : "?";
+}
+
+static std::atomic<const Ajiva::Core::LogSite*> firstLogSite{nullptr};
+
+Ajiva::Core::LogSite::LogSite(const char* file, u32 line) : File(file), Line(line)
+{
+    next = firstLogSite.load(std::memory_order_relaxed);
+    while (!firstLogSite.compare_exchange_weak(next, this, std::memory_order_release, std::memory_order_relaxed))
+    {
+    }
+}
+
+const Ajiva::Core::LogSite* Ajiva::Core::LogSite::First()
+{
+    return firstLogSite.load(std::memory_order_acquire);
+}
+
+u64 Ajiva::Core::LogSite::Emit(u64 hit)
+{
+    emitted.fetch_add(1, std::memory_order_relaxed);
+    // hits between the previous record of this site and this one. two threads may get here in the other order than
+    // they counted their hits, the later hit keeps the mark and the earlier one reports nothing
+    u64 last = lastEmitHit.load(std::memory_order_relaxed);
+    do
+    {
+        if (hit < last) return 0;
+    }
+    while (!lastEmitHit.compare_exchange_weak(last, hit + 1, std::memory_order_relaxed));
+    return hit - last;
+}
+
+bool Ajiva::Core::LogSite::Once(u64& repeats)
+{
+    if (hits.fetch_add(1, std::memory_order_relaxed)) return false;
+    repeats = Emit(0);
+    return true;
+}
+
+bool Ajiva::Core::LogSite::EveryN(u64 n, u64& repeats)
+{
+    const u64 hit = hits.fetch_add(1, std::memory_order_relaxed);
+    if (n > 1 && hit % n) return false;
+    repeats = Emit(hit);
+    return true;
+}
+
+bool Ajiva::Core::LogSite::EveryMs(u64 ms, u64& repeats)
+{
+    const u64 hit = hits.fetch_add(1, std::memory_order_relaxed);
+    const u64 now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    u64 next = nextNs.load(std::memory_order_relaxed);
+    if (now < next) return false;
+    // one thread wins the slot, the others count as repeats
+    if (!nextNs.compare_exchange_strong(next, now + ms * 1000000, std::memory_order_relaxed)) return false;
+    repeats = Emit(hit);
+    return true;
+}
+
+std::string Ajiva::Core::LogRepeats(u64 repeats)
+{
+    if (!repeats) return {};
+    std::string digits = std::to_string(repeats);
+    for (i64 i = static_cast<i64>(digits.size()) - 3; i > 0; i -= 3)
+        digits.insert(static_cast<u64>(i), ",");
+    return "(suppressed " + digits + (repeats == 1 ? " repeat) " : " repeats) ");
+}
+
+void Ajiva::Core::ReportSuppressedLogs()
+{
+    for (auto* site = LogSite::First(); site; site = site->Next())
+    {
+        if (const u64 suppressed = site->Suppressed())
+        {
+            PLOG_INFO << site->File << ":" << site->Line << " suppressed " << suppressed << " of " << site->Hits()
+                << " records";
+        }
+    }
+}
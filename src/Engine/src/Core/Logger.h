@@ -5,11 +5,139 @@
 
 #include "defines.h"
 
+#include <atomic>
+#include <string>
+
+#ifndef AJ_LOG_QUEUE_LENGTH
+#define AJ_LOG_QUEUE_LENGTH 8192
+#endif
+
 namespace Ajiva::Core
 {
+    // what a full async log queue does to the caller, errors and fatals always wait
+    enum class LogOverflowPolicy : u8
+    {
+        Drop,
+        Block,
+    };
+
+    struct LoggerConfig
+    {
+        bool Async = true; // format and write on a background thread
+        u64 QueueCapacity = AJ_LOG_QUEUE_LENGTH; // power of two
+        LogOverflowPolicy Overflow = LogOverflowPolicy::Drop;
+    };
+
+    // runtime severity threshold per engine module, see AJ_LOG
+    enum class LogModule : u8
+    {
+        Core,
+        Renderer,
+        Resource,
+        Platform,
+        App,
+        Count,
+    };
+
+    inline std::atomic<u8> LogThresholds[static_cast<u8>(LogModule::Count)] = {
+        plog::verbose, plog::verbose, plog::verbose, plog::verbose, plog::verbose
+    };
+
+    AJ_INLINE bool LogEnabled(LogModule module, plog::Severity severity)
+    {
+        return severity <= LogThresholds[static_cast<u8>(module)].load(std::memory_order_relaxed);
+    }
+
+    AJ_API void SetLogThreshold(LogModule module, plog::Severity severity);
+
+    AJ_API const char* LogModuleName(LogModule module);
+
+    // One per AJ_LOG_ONCE / AJ_LOG_EVERY_* line, counts how often the line was reached and how often it was let
+    // through. A suppressed hit costs one relaxed increment.
+    class AJ_API LogSite
+    {
+    public:
+        LogSite(const char* file, u32 line);
+
+        bool Once(u64& repeats);
+
+        bool EveryN(u64 n, u64& repeats);
+
+        bool EveryMs(u64 ms, u64& repeats);
+
+        [[nodiscard]] u64 Hits() const
+        {
+            return hits.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] u64 Suppressed() const
+        {
+            return Hits() - emitted.load(std::memory_order_relaxed);
+        }
+
+        // every site constructed so far, newest first
+        [[nodiscard]] static const LogSite* First();
+
+        [[nodiscard]] const LogSite* Next() const
+        {
+            return next;
+        }
+
+        const char* const File;
+        const u32 Line;
+
+    private:
+        std::atomic<u64> hits{0};
+        std::atomic<u64> emitted{0};
+        std::atomic<u64> lastEmitHit{0};
+        std::atomic<u64> nextNs{0};
+        const LogSite* next = nullptr;
+
+        u64 Emit(u64 hit);
+    };
+
+    // "(suppressed 12,345 repeats) " in front of a record that stands for others, nothing otherwise
+    AJ_API std::string LogRepeats(u64 repeats);
+
+    // one line per site that dropped records, ShutdownLogger does this too
+    AJ_API void ReportSuppressedLogs();
+
     AJ_API void ShowAppLog(bool* p_open);
 
-    AJ_API void SetupLogger();
+    AJ_API void SetupLogger(const LoggerConfig& config = {});
+
+    // waits until every record logged so far was written
+    AJ_API void FlushLogger();
+
+    // flushes and stops the background writer, logging afterwards is synchronous
+    AJ_API void ShutdownLogger();
 }
 
 #define AJ_FAIL(...) PLOG_FATAL << __VA_ARGS__; throw std::runtime_error(__VA_ARGS__)
+
+// PLOG(severity) behind the threshold of module, a disabled level costs one branch: AJ_LOG(Renderer, debug) << ...
+#define AJ_LOG(module, severity)                                                                                  \
+    if (!::Ajiva::Core::LogEnabled(::Ajiva::Core::LogModule::module, plog::severity)) {}                           \
+    else PLOG(plog::severity)
+
+// a lambda is unique per expansion, so is its static
+#define AJ_LOG_SITE()                                                                                             \
+    ([]() -> ::Ajiva::Core::LogSite&                                                                              \
+    {                                                                                                             \
+        static ::Ajiva::Core::LogSite site(__FILE__, __LINE__);                                                   \
+        return site;                                                                                              \
+    }())
+
+#define AJ_LOG_LIMITED(module, severity, check)                                                                   \
+    if (u64 ajLogRepeats = 0; !::Ajiva::Core::LogEnabled(::Ajiva::Core::LogModule::module, plog::severity) ||     \
+        !AJ_LOG_SITE().check) {}                                                                                  \
+    else PLOG(plog::severity) << ::Ajiva::Core::LogRepeats(ajLogRepeats)
+
+// the first time the line is reached, later hits are only counted
+#define AJ_LOG_ONCE(module, severity) AJ_LOG_LIMITED(module, severity, Once(ajLogRepeats))
+
+// every n-th time the line is reached
+#define AJ_LOG_EVERY_N(module, severity, n) AJ_LOG_LIMITED(module, severity, EveryN(n, ajLogRepeats))
+
+// at most once per ms milliseconds, the record says how many it stands for
+#define AJ_LOG_EVERY_MS(module, severity, ms) AJ_LOG_LIMITED(module, severity, EveryMs(ms, ajLogRepeats))
@@ -0,0 +1,74 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#include "MainThreadDispatcher.h"
+
+namespace Ajiva::Core
+{
+    MainThreadDispatcher::MainThreadDispatcher(u64 capacity)
+        : mainThread(std::this_thread::get_id()), queue(capacity)
+    {
+    }
+
+    void MainThreadDispatcher::Post(TaskFunction func)
+    {
+        if (!func) return;
+        // keep posts behind the overflow once it is in use, otherwise they would overtake older work
+        if (overflowCount.load(std::memory_order_acquire) == 0 && queue.TryPush(std::move(func)))
+            return;
+        std::lock_guard<std::mutex> lock(overflowMutex);
+        overflow.push_back(std::move(func));
+        overflowCount.fetch_add(1, std::memory_order_release);
+    }
+
+    u64 MainThreadDispatcher::Drain(std::chrono::microseconds budget)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + budget;
+        u64 executed = 0;
+        TaskFunction func;
+        while (TryTake(func))
+        {
+            func();
+            func = nullptr;
+            ++executed;
+            if (std::chrono::steady_clock::now() >= deadline)
+                break;
+        }
+        return executed;
+    }
+
+    u64 MainThreadDispatcher::DrainAll()
+    {
+        u64 executed = 0;
+        TaskFunction func;
+        while (TryTake(func))
+        {
+            func();
+            func = nullptr;
+            ++executed;
+        }
+        return executed;
+    }
+
+    u64 MainThreadDispatcher::Pending() const
+    {
+        return queue.Size() + overflowCount.load(std::memory_order_relaxed);
+    }
+
+    bool MainThreadDispatcher::TryTake(TaskFunction& func)
+    {
+        if (queue.TryPop(func))
+            return true;
+        if (overflowCount.load(std::memory_order_acquire) == 0)
+            return false;
+        std::lock_guard<std::mutex> lock(overflowMutex);
+        if (overflow.empty())
+            return false;
+        func = std::move(overflow.front());
+        overflow.pop_front();
+        overflowCount.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+} // Ajiva
+// Core
@@ -0,0 +1,62 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#pragma once
+
+#include "defines.h"
+#include "Core/InlineFunction.h"
+#include "Core/MpmcQueue.h"
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#ifndef AJ_MAIN_THREAD_QUEUE_LENGTH
+#define AJ_MAIN_THREAD_QUEUE_LENGTH 1024
+#endif
+
+namespace Ajiva::Core
+{
+    // Continuations that have to run on the main/render thread (anything touching GPU objects the frame uses).
+    // Post never blocks: once the ring is full, work goes to a locked overflow list that is drained after the ring.
+    class AJ_API MainThreadDispatcher
+    {
+    public:
+        // the constructing thread is the main thread
+        explicit MainThreadDispatcher(u64 capacity = AJ_MAIN_THREAD_QUEUE_LENGTH);
+
+        MainThreadDispatcher(const MainThreadDispatcher&) = delete;
+        MainThreadDispatcher& operator=(const MainThreadDispatcher&) = delete;
+
+        // callable from any thread
+        void Post(TaskFunction func);
+
+        // runs posted work until nothing is left or the budget is used up, whatever remains rolls over to the
+        // next call. At least one item runs per call so a single long item cannot stall the queue forever.
+        // returns the number of executed items
+        u64 Drain(std::chrono::microseconds budget);
+
+        // runs everything, used on shutdown
+        u64 DrainAll();
+
+        [[nodiscard]] u64 Pending() const;
+
+        [[nodiscard]] AJ_INLINE bool IsMainThread() const
+        {
+            return std::this_thread::get_id() == mainThread;
+        }
+
+    private:
+        std::thread::id mainThread;
+        MpmcQueue<TaskFunction> queue;
+        std::atomic<u64> overflowCount{0};
+        mutable std::mutex overflowMutex;
+        std::deque<TaskFunction> overflow;
+
+        bool TryTake(TaskFunction& func);
+    };
+} // Ajiva
+// Core
@@ -0,0 +1,138 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#pragma once
+
+#include "defines.h"
+#include "Core/Logger.h"
+
+#include <atomic>
+#include <memory>
+#include <optional>
+
+namespace Ajiva::Core
+{
+    // Bounded lock-free multi producer / multi consumer ring (D. Vyukov).
+    // Every slot carries a sequence number, so producers and consumers only contend on their own cursor.
+    template <typename T>
+    class MpmcQueue
+    {
+        struct Cell
+        {
+            std::atomic<u64> sequence;
+            T data;
+        };
+
+    public:
+        explicit MpmcQueue(u64 capacity) : mask(capacity - 1), cells(new Cell[capacity])
+        {
+            if (capacity < 2 || (capacity & (capacity - 1)) != 0)
+            {
+                AJ_FAIL("MpmcQueue capacity must be a power of two!");
+            }
+            for (u64 i = 0; i < capacity; ++i)
+            {
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        MpmcQueue(const MpmcQueue&) = delete;
+        MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+        // position is the slot in push order, pops hand values out in that order
+        template <typename U>
+        bool TryPush(U&& value, u64* position = nullptr)
+        {
+            u64 pos = enqueuePos.load(std::memory_order_relaxed);
+            Cell* cell;
+            for (;;)
+            {
+                cell = &cells[pos & mask];
+                u64 seq = cell->sequence.load(std::memory_order_acquire);
+                i64 diff = static_cast<i64>(seq) - static_cast<i64>(pos);
+                if (diff == 0)
+                {
+                    if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                {
+                    return false; // full
+                }
+                else
+                {
+                    pos = enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+            cell->data = std::forward<U>(value);
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            if (position) *position = pos;
+            return true;
+        }
+
+        bool TryPop(T& out)
+        {
+            u64 pos = dequeuePos.load(std::memory_order_relaxed);
+            Cell* cell;
+            for (;;)
+            {
+                cell = &cells[pos & mask];
+                u64 seq = cell->sequence.load(std::memory_order_acquire);
+                i64 diff = static_cast<i64>(seq) - static_cast<i64>(pos + 1);
+                if (diff == 0)
+                {
+                    if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                {
+                    return false; // empty
+                }
+                else
+                {
+                    pos = dequeuePos.load(std::memory_order_relaxed);
+                }
+            }
+            out = std::move(cell->data);
+            cell->sequence.store(pos + mask + 1, std::memory_order_release);
+            return true;
+        }
+
+        // values pushed (or being pushed) so far
+        [[nodiscard]] AJ_INLINE u64 EnqueuePosition() const
+        {
+            return enqueuePos.load(std::memory_order_acquire);
+        }
+
+        // approximate, exact only while no other thread touches the queue
+        [[nodiscard]] AJ_INLINE u64 Size() const
+        {
+            u64 e = enqueuePos.load(std::memory_order_relaxed);
+            u64 d = dequeuePos.load(std::memory_order_relaxed);
+            return e > d ? e - d : 0;
+        }
+
+        [[nodiscard]] AJ_INLINE bool IsEmpty() const
+        {
+            return Size() == 0;
+        }
+
+        [[nodiscard]] AJ_INLINE bool IsFull() const
+        {
+            return Size() > mask;
+        }
+
+        [[nodiscard]] AJ_INLINE u64 Capacity() const
+        {
+            return mask + 1;
+        }
+
+    private:
+        u64 mask;
+        std::unique_ptr<Cell[]> cells;
+        alignas(64) std::atomic<u64> enqueuePos{0};
+        alignas(64) std::atomic<u64> dequeuePos{0};
+    };
+} // Ajiva
+// Core
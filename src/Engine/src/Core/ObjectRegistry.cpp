@@ -0,0 +1,116 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#include "ObjectRegistry.h"
+#include "Core/Logger.h"
+
+namespace Ajiva::Core
+{
+    ObjectRegistry& ObjectRegistry::Get()
+    {
+        // never destroyed, statics may still unregister during exit
+        static auto* registry = new ObjectRegistry();
+        return *registry;
+    }
+
+    u32 ObjectRegistry::TypeIndex(const std::type_info& type)
+    {
+        for (u32 i = 0; i < MaxTypes - 1; ++i)
+        {
+            const std::type_info* slot = types[i].type.load(std::memory_order_acquire);
+            if (!slot && types[i].type.compare_exchange_strong(slot, &type, std::memory_order_acq_rel))
+                return i;
+            // type_info objects may be duplicated across modules, compare them, not their addresses
+            if (*slot == type)
+                return i;
+        }
+        return MaxTypes - 1;
+    }
+
+    void ObjectRegistry::Register(const void* object, const std::type_info& type, u64 bytes)
+    {
+        const u32 index = TypeIndex(type);
+        auto& shard = ShardOf(object);
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            if (!shard.objects.try_emplace(object, Entry{index, bytes}).second)
+            {
+                AJ_LOG_EVERY_MS(Core, error, 1000) << "ObjectRegistry: " << type.name() << " at " << object
+                    << " registered twice";
+                return;
+            }
+        }
+        auto& slot = types[index];
+        slot.live.fetch_add(1, std::memory_order_relaxed);
+        slot.bytes.fetch_add(bytes, std::memory_order_relaxed);
+        slot.created.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void ObjectRegistry::Unregister(const void* object, const std::type_info* type)
+    {
+        Entry entry;
+        auto& shard = ShardOf(object);
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            const auto it = shard.objects.find(object);
+            if (it == shard.objects.end())
+            {
+                AJ_LOG_EVERY_MS(Core, error, 1000) << "ObjectRegistry: " << object << " was never registered";
+                return;
+            }
+            entry = it->second;
+            shard.objects.erase(it);
+        }
+        auto& slot = types[entry.Type];
+        // the shared last slot does not know its types
+        const std::type_info* registered = slot.type.load(std::memory_order_acquire);
+        if (type && entry.Type < MaxTypes - 1 && registered && *registered != *type)
+        {
+            AJ_LOG_EVERY_MS(Core, error, 1000) << "ObjectRegistry: " << object << " registered as "
+                << registered->name() << " destroyed as " << type->name();
+        }
+        slot.live.fetch_sub(1, std::memory_order_relaxed);
+        slot.bytes.fetch_sub(entry.Bytes, std::memory_order_relaxed);
+    }
+
+    u64 ObjectRegistry::LiveCount() const
+    {
+        u64 live = 0;
+        for (const auto& slot : types)
+            live += slot.live.load(std::memory_order_relaxed);
+        return live;
+    }
+
+    std::vector<ObjectTypeStats> ObjectRegistry::Stats() const
+    {
+        std::vector<ObjectTypeStats> stats;
+        for (u32 i = 0; i < MaxTypes; ++i)
+        {
+            const auto& slot = types[i];
+            const std::type_info* type = slot.type.load(std::memory_order_acquire);
+            const u64 created = slot.created.load(std::memory_order_relaxed);
+            if (!type && !created) continue;
+            stats.push_back({
+                type ? type->name() : "other", slot.live.load(std::memory_order_relaxed),
+                slot.bytes.load(std::memory_order_relaxed), created
+            });
+        }
+        return stats;
+    }
+
+    void ObjectRegistry::ForEachLive(
+        const std::function<void(const char* type, const void* object, u64 bytes)>& callback) const
+    {
+        for (const auto& shard : shards)
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (const auto& [object, entry] : shard.objects)
+            {
+                const std::type_info* type = types[entry.Type].type.load(std::memory_order_acquire);
+                callback(type ? type->name() : "other", object, entry.Bytes);
+            }
+        }
+    }
+} // Ajiva
+// Core
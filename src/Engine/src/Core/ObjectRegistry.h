@@ -0,0 +1,96 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#pragma once
+
+#include "defines.h"
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+// 0 compiles AJ_RegisterCreated / AJ_RegisterDestroyed to nothing, off in release builds by default
+#ifndef AJ_TRACK_OBJECTS
+#ifdef NDEBUG
+#define AJ_TRACK_OBJECTS 0
+#else
+#define AJ_TRACK_OBJECTS 1
+#endif
+#endif
+
+namespace Ajiva::Core
+{
+    struct ObjectTypeStats
+    {
+        const char* Name;
+        u64 Live;
+        u64 Bytes; // of the live objects, as far as they told
+        u64 Created;
+    };
+
+    // Live objects of tracked types for the leak check. Objects are spread over shards by address, each with its own
+    // lock and hash map, so register and unregister are O(1) and threads rarely meet. The per type counters are
+    // atomics and can be read at any time.
+    class AJ_API ObjectRegistry
+    {
+    public:
+        static constexpr u32 ShardCount = 64;
+        static constexpr u32 MaxTypes = 64; // later types share the last slot
+
+        static ObjectRegistry& Get();
+
+        void Register(const void* object, const std::type_info& type, u64 bytes = 0);
+
+        // type, if given, has to match the registered one
+        void Unregister(const void* object, const std::type_info* type = nullptr);
+
+        [[nodiscard]] u64 LiveCount() const;
+
+        [[nodiscard]] std::vector<ObjectTypeStats> Stats() const;
+
+        // every live object, one shard locked at a time
+        void ForEachLive(const std::function<void(const char* type, const void* object, u64 bytes)>& callback) const;
+
+    private:
+        struct Entry
+        {
+            u32 Type;
+            u64 Bytes;
+        };
+
+        struct alignas(64) Shard
+        {
+            mutable std::mutex mutex;
+            std::unordered_map<const void*, Entry> objects;
+        };
+
+        struct alignas(64) TypeSlot
+        {
+            std::atomic<const std::type_info*> type{nullptr};
+            std::atomic<u64> live{0};
+            std::atomic<u64> bytes{0};
+            std::atomic<u64> created{0};
+        };
+
+        Shard shards[ShardCount];
+        TypeSlot types[MaxTypes];
+
+        ObjectRegistry() = default;
+
+        u32 TypeIndex(const std::type_info& type);
+
+        Shard& ShardOf(const void* object)
+        {
+            // fibonacci hashing, allocations are at least 16 byte aligned
+            const u64 key = reinterpret_cast<u64>(object) >> 4;
+            return shards[(key * 11400714819323198485ull) >> 58];
+        }
+
+        static_assert(ShardCount == 64, "ShardOf takes the top 6 bits");
+    };
+} // Ajiva
+// Core
@@ -0,0 +1,207 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#pragma once
+
+#include "defines.h"
+#include "Core/ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Ajiva::Core
+{
+    namespace Detail
+    {
+        // Shared between the caller and its helpers. Chunks are claimed with guided self-scheduling:
+        // every claim takes remaining / (2 * participants) items (at least grain), so early chunks are big and the
+        // tail gets split finer. The caller claims chunks itself too, so it never depends on a helper being started,
+        // which keeps nested calls from inside pool work deadlock free.
+        struct ParallelState
+        {
+            std::atomic<u64> next;
+            std::atomic<u64> processed{0};
+            u64 end;
+            u64 grain;
+            u64 participants;
+
+            ParallelState(u64 begin, u64 end, u64 grain, u64 participants)
+                : next(begin), end(end), grain(grain), participants(participants)
+            {
+            }
+
+            // only depends on where the chunk starts, so the chunk boundaries are the same on every run
+            [[nodiscard]] u64 ChunkSize(u64 current) const
+            {
+                const u64 remaining = end - current;
+                return std::min(std::max(grain, remaining / (2 * participants)), remaining);
+            }
+
+            bool Claim(u64& chunkBegin, u64& chunkEnd)
+            {
+                u64 current = next.load(std::memory_order_relaxed);
+                for (;;)
+                {
+                    if (current >= end)
+                        return false;
+                    const u64 size = ChunkSize(current);
+                    if (next.compare_exchange_weak(current, current + size, std::memory_order_relaxed))
+                    {
+                        chunkBegin = current;
+                        chunkEnd = current + size;
+                        return true;
+                    }
+                }
+            }
+
+            void WaitForCompletion(u64 total) const
+            {
+                while (processed.load(std::memory_order_acquire) < total)
+                {
+                    // only chunks that were already claimed are outstanding, they are being executed right now
+                    std::this_thread::yield();
+                }
+            }
+        };
+
+        template <typename F>
+        AJ_INLINE void InvokeChunk(const F& fn, u64 begin, u64 end)
+        {
+            if constexpr (std::is_invocable_v<const F&, u64, u64>)
+            {
+                fn(begin, end);
+            }
+            else
+            {
+                for (u64 i = begin; i < end; ++i)
+                {
+                    fn(i);
+                }
+            }
+        }
+
+        AJ_INLINE u64 Participants(IThreadPool* pool, u64 count, u64 grain)
+        {
+            u64 chunks = (count + grain - 1) / grain;
+            return std::min<u64>(pool->WorkerCount() + 1, chunks);
+        }
+    }
+
+    // fn is either fn(u64 index) or fn(u64 chunkBegin, u64 chunkEnd).
+    // grain is the smallest chunk worth shipping to another thread, a range that fits into one grain runs inline.
+    template <typename F>
+    void ParallelFor(IThreadPool* pool, u64 begin, u64 end, u64 grain, const F& fn)
+    {
+        if (end <= begin) return;
+        const u64 count = end - begin;
+        grain = std::max<u64>(grain, 1);
+        if (!pool || count <= grain || pool->WorkerCount() == 0)
+        {
+            Detail::InvokeChunk(fn, begin, end);
+            return;
+        }
+
+        const u64 participants = Detail::Participants(pool, count, grain);
+        auto state = CreateRef<Detail::ParallelState>(begin, end, grain, participants);
+        auto run = [state, &fn]()
+        {
+            u64 chunkBegin, chunkEnd;
+            while (state->Claim(chunkBegin, chunkEnd))
+            {
+                Detail::InvokeChunk(fn, chunkBegin, chunkEnd);
+                state->processed.fetch_add(chunkEnd - chunkBegin, std::memory_order_release);
+            }
+        };
+        // helpers inherit the lane of the caller, a frame waiting on them must not queue behind background work
+        const WorkPriority priority = pool->CurrentPriority();
+        for (u64 i = 1; i < participants; ++i)
+        {
+            // helpers that start late find nothing to claim and never touch fn
+            pool->QueueWork(run, nullptr, priority);
+        }
+        run();
+        state->WaitForCompletion(count);
+    }
+
+    template <typename F>
+    void ParallelFor(IThreadPool* pool, u64 begin, u64 end, const F& fn)
+    {
+        ParallelFor(pool, begin, end, 1, fn);
+    }
+
+    // map(chunkBegin, chunkEnd) -> T produces a partial result, reduce(T, T) -> T combines them.
+    // reduce has to be associative but not commutative, there is one partial per chunk and they are combined in
+    // index order, so the result does not depend on which thread ran which chunk.
+    template <typename T, typename Map, typename Reduce>
+    T ParallelReduce(IThreadPool* pool, u64 begin, u64 end, u64 grain, T identity, const Map& map,
+                     const Reduce& reduce)
+    {
+        if (end <= begin) return identity;
+        const u64 count = end - begin;
+        grain = std::max<u64>(grain, 1);
+        if (!pool || count <= grain || pool->WorkerCount() == 0)
+        {
+            return reduce(identity, map(begin, end));
+        }
+
+        // the chunks are laid out up front and handed out by index, a partial is stored at the index of its chunk
+        struct ReduceState : Detail::ParallelState
+        {
+            std::vector<u64> starts;
+            std::vector<T> partials;
+            std::atomic<u64> nextChunk{0};
+
+            ReduceState(u64 begin, u64 end, u64 grain, u64 participants, const T& identity)
+                : ParallelState(begin, end, grain, participants)
+            {
+                for (u64 current = begin; current < end; current += ChunkSize(current))
+                    starts.push_back(current);
+                partials.resize(starts.size(), identity);
+            }
+
+            bool ClaimChunk(u64& index, u64& chunkBegin, u64& chunkEnd)
+            {
+                index = nextChunk.fetch_add(1, std::memory_order_relaxed);
+                if (index >= starts.size())
+                    return false;
+                chunkBegin = starts[index];
+                chunkEnd = index + 1 < starts.size() ? starts[index + 1] : end;
+                return true;
+            }
+        };
+
+        const u64 participants = Detail::Participants(pool, count, grain);
+        auto state = CreateRef<ReduceState>(begin, end, grain, participants, identity);
+        auto run = [state, &map]()
+        {
+            u64 index, chunkBegin, chunkEnd;
+            u64 done = 0;
+            while (state->ClaimChunk(index, chunkBegin, chunkEnd))
+            {
+                state->partials[index] = map(chunkBegin, chunkEnd);
+                done += chunkEnd - chunkBegin;
+            }
+            // publishes the partials written above
+            if (done) state->processed.fetch_add(done, std::memory_order_release);
+        };
+        const WorkPriority priority = pool->CurrentPriority();
+        for (u64 i = 1; i < participants; ++i)
+        {
+            pool->QueueWork(run, nullptr, priority);
+        }
+        run();
+        state->WaitForCompletion(count);
+
+        T result = identity;
+        for (auto& partial : state->partials)
+        {
+            result = reduce(result, std::move(partial));
+        }
+        return result;
+    }
+} // Ajiva
+// Core
@@ -0,0 +1,238 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#include "Profiler.h"
+#include "Core/Logger.h"
+
+#include <algorithm>
+#include <fstream>
+
+namespace Ajiva::Core
+{
+    static thread_local u64 threadFrame = 0;
+
+    Profiler& Profiler::Get()
+    {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    u64 Profiler::CurrentFrame()
+    {
+        return threadFrame;
+    }
+
+    void Profiler::SetCurrentFrame(u64 frame)
+    {
+        threadFrame = frame;
+    }
+
+    void Profiler::SetThreadName(const std::string& name)
+    {
+        auto& buffer = LocalBuffer();
+        std::lock_guard<std::mutex> lock(Get().threadsMutex);
+        buffer.name = name;
+    }
+
+    void Profiler::SetBufferLength(u64 length)
+    {
+        Get().bufferLength.store(std::max<u64>(length, 1), std::memory_order_relaxed);
+    }
+
+    const char* Profiler::Intern(std::string_view name)
+    {
+        auto& profiler = Get();
+        std::lock_guard<std::mutex> lock(profiler.internMutex);
+        return profiler.interned.emplace(name).first->c_str();
+    }
+
+    Profiler::ThreadBuffer& Profiler::LocalBuffer()
+    {
+        // buffers are never freed, a thread that exits leaves its last scopes for the collector
+        static thread_local ThreadBuffer* local = nullptr;
+        if (!local)
+        {
+            auto& profiler = Get();
+            auto buffer = std::make_unique<ThreadBuffer>();
+            std::lock_guard<std::mutex> lock(profiler.threadsMutex);
+            buffer->index = static_cast<u32>(profiler.threads.size());
+            buffer->name = "Thread " + std::to_string(buffer->index);
+            local = buffer.get();
+            profiler.threads.push_back(std::move(buffer));
+        }
+        return *local;
+    }
+
+    u32 Profiler::Enter()
+    {
+        return LocalBuffer().depth++;
+    }
+
+    void Profiler::Leave(const char* name, u64 startNs, u32 depth)
+    {
+        const u64 end = NowNs();
+        auto& buffer = LocalBuffer();
+        buffer.depth = depth;
+        if (!buffer.events)
+        {
+            // the collector only reads below head, which is published after this
+            buffer.capacity = Get().bufferLength.load(std::memory_order_relaxed);
+            buffer.events = std::make_unique<ProfileEvent[]>(buffer.capacity);
+        }
+        const u64 head = buffer.head.load(std::memory_order_relaxed);
+        if (head - buffer.tail.load(std::memory_order_acquire) >= buffer.capacity)
+        {
+            buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        buffer.events[head % buffer.capacity] = {name, startNs, end, threadFrame, depth, buffer.index};
+        buffer.head.store(head + 1, std::memory_order_release);
+    }
+
+    void Profiler::BeginFrame()
+    {
+        SetCurrentFrame(++frame);
+    }
+
+    void Profiler::EndFrame()
+    {
+        Collect();
+        // pool tasks of the last captured frame may still be running, give them a frame before writing
+        if (captureEnd && frame > captureEnd)
+        {
+            WriteCapture();
+        }
+    }
+
+    void Profiler::CaptureFrames(u32 count, const std::filesystem::path& path)
+    {
+        if (IsCapturing() || !count) return;
+        capturePath = path;
+        captureStart = frame + 1;
+        captureEnd = captureStart + count;
+        captured.clear();
+        PLOG_INFO << "Profiler: capturing " << count << " frames to " << path;
+    }
+
+    void Profiler::Collect()
+    {
+        std::vector<ThreadBuffer*> buffers;
+        {
+            std::lock_guard<std::mutex> lock(threadsMutex);
+            buffers.reserve(threads.size());
+            for (auto& thread : threads)
+                buffers.push_back(thread.get());
+        }
+
+        for (auto buffer : buffers)
+        {
+            const u64 tail = buffer->tail.load(std::memory_order_relaxed);
+            const u64 head = buffer->head.load(std::memory_order_acquire);
+            for (u64 i = tail; i < head; ++i)
+            {
+                const auto& event = buffer->events[i % buffer->capacity];
+                history.push_back(event);
+                if (captureEnd && event.Frame >= captureStart && event.Frame < captureEnd)
+                    captured.push_back(event);
+            }
+            buffer->tail.store(head, std::memory_order_release);
+        }
+
+        const u64 oldest = frame > HistoryFrames ? frame - HistoryFrames : 0;
+        std::erase_if(history, [oldest](const ProfileEvent& event) { return event.Frame < oldest; });
+    }
+
+    std::vector<ProfileEvent> Profiler::FrameEvents(u64 frame) const
+    {
+        std::vector<ProfileEvent> events;
+        for (const auto& event : history)
+        {
+            if (event.Frame == frame) events.push_back(event);
+        }
+        std::sort(events.begin(), events.end(), [](const ProfileEvent& a, const ProfileEvent& b)
+        {
+            return a.Thread != b.Thread ? a.Thread < b.Thread : a.StartNs < b.StartNs;
+        });
+        return events;
+    }
+
+    std::vector<std::string> Profiler::ThreadNames() const
+    {
+        std::lock_guard<std::mutex> lock(threadsMutex);
+        std::vector<std::string> names;
+        names.reserve(threads.size());
+        for (const auto& thread : threads)
+            names.push_back(thread->name);
+        return names;
+    }
+
+    u64 Profiler::DroppedCount() const
+    {
+        std::lock_guard<std::mutex> lock(threadsMutex);
+        u64 dropped = 0;
+        for (const auto& thread : threads)
+            dropped += thread->dropped.load(std::memory_order_relaxed);
+        return dropped;
+    }
+
+    static void WriteJsonString(std::ostream& out, std::string_view text)
+    {
+        out << '"';
+        for (const char c : text)
+        {
+            if (c == '"' || c == '\\') out << '\\' << c;
+            else if (static_cast<unsigned char>(c) < 0x20) out << ' ';
+            else out << c;
+        }
+        out << '"';
+    }
+
+    void Profiler::WriteCapture()
+    {
+        const u64 frames = captureEnd - captureStart;
+        captureStart = 0;
+        captureEnd = 0;
+
+        std::ofstream out(capturePath, std::ios::trunc);
+        if (!out.is_open())
+        {
+            PLOG_ERROR << "Profiler: failed to open " << capturePath;
+            captured.clear();
+            return;
+        }
+
+        u64 origin = ~0ull;
+        for (const auto& event : captured)
+            origin = std::min(origin, event.StartNs);
+
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        bool first = true;
+        const auto names = ThreadNames();
+        for (u64 i = 0; i < names.size(); ++i)
+        {
+            out << (first ? "" : ",\n") << R"({"ph":"M","pid":1,"name":"thread_name","tid":)" << i
+                << R"(,"args":{"name":)";
+            WriteJsonString(out, names[i]);
+            out << "}}";
+            first = false;
+        }
+        out.setf(std::ios::fixed);
+        out.precision(3);
+        for (const auto& event : captured)
+        {
+            out << (first ? "" : ",\n") << R"({"ph":"X","pid":1,"tid":)" << event.Thread << ",\"name\":";
+            WriteJsonString(out, event.Name);
+            out << ",\"ts\":" << static_cast<f64>(event.StartNs - origin) / 1000.0
+                << ",\"dur\":" << static_cast<f64>(event.EndNs - event.StartNs) / 1000.0
+                << ",\"args\":{\"frame\":" << event.Frame << "}}";
+            first = false;
+        }
+        out << "\n]}\n";
+
+        PLOG_INFO << "Profiler: wrote " << captured.size() << " scopes of " << frames << " frames to "
+                  << capturePath;
+        captured.clear();
+    }
+} // Ajiva
+// Core
@@ -0,0 +1,197 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#pragma once
+
+#include "defines.h"
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+// 0 compiles every AJ_PROFILE_* macro to nothing
+#ifndef AJ_PROFILING
+#define AJ_PROFILING 1
+#endif
+
+// default for the scopes a thread may record between two collections (once a frame), later ones are counted as
+// dropped. 40 bytes each, allocated with the first scope a thread records, see Profiler::SetBufferLength
+#ifndef AJ_PROFILER_BUFFER_LENGTH
+#define AJ_PROFILER_BUFFER_LENGTH 4096
+#endif
+
+namespace Ajiva::Core
+{
+    struct ProfileEvent
+    {
+        const char* Name; // static or interned, never freed
+        u64 StartNs;
+        u64 EndNs;
+        u64 Frame; // frame that caused the work, pool tasks inherit it from the submitting thread
+        u32 Depth;
+        u32 Thread;
+    };
+
+    // Hierarchical CPU scopes. Every thread writes into its own single producer ring, the main thread collects
+    // all rings once a frame in EndFrame, nothing on the recording side takes a lock.
+    class AJ_API Profiler
+    {
+        struct ThreadBuffer
+        {
+            std::atomic<u64> head{0}; // written by the owning thread
+            std::atomic<u64> tail{0}; // written by the collector
+            std::atomic<u64> dropped{0};
+            u32 index = 0;
+            u32 depth = 0;
+            u64 capacity = 0;
+            std::string name;
+            std::unique_ptr<ProfileEvent[]> events; // null until the thread records its first scope
+        };
+
+    public:
+        static constexpr u64 HistoryFrames = 8;
+
+        static Profiler& Get();
+
+        AJ_INLINE static u64 NowNs()
+        {
+            return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        // frame new scopes on this thread are attributed to
+        static u64 CurrentFrame();
+
+        static void SetCurrentFrame(u64 frame);
+
+        // shown in the trace, call once from the thread itself
+        static void SetThreadName(const std::string& name);
+
+        // ring length for threads that record their first scope after this call
+        static void SetBufferLength(u64 length);
+
+        // stable pointer for a runtime string, for scope names that are not literals
+        static const char* Intern(std::string_view name);
+
+        // scopes use these, depth is tracked per thread
+        static u32 Enter();
+
+        static void Leave(const char* name, u64 startNs, u32 depth);
+
+        // main thread, around everything a frame does
+        void BeginFrame();
+
+        void EndFrame();
+
+        [[nodiscard]] u64 Frame() const
+        {
+            return frame;
+        }
+
+        // writes the next count frames to path as Chrome trace JSON (chrome://tracing, ui.perfetto.dev)
+        void CaptureFrames(u32 count, const std::filesystem::path& path);
+
+        [[nodiscard]] bool IsCapturing() const
+        {
+            return captureEnd != 0;
+        }
+
+        // collected events of one of the last HistoryFrames frames, sorted by thread and start
+        [[nodiscard]] std::vector<ProfileEvent> FrameEvents(u64 frame) const;
+
+        [[nodiscard]] std::vector<std::string> ThreadNames() const;
+
+        [[nodiscard]] u64 DroppedCount() const;
+
+    private:
+        std::atomic<u64> bufferLength{AJ_PROFILER_BUFFER_LENGTH};
+        mutable std::mutex threadsMutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> threads;
+        std::mutex internMutex;
+        std::unordered_set<std::string> interned;
+
+        u64 frame = 0;
+        std::deque<ProfileEvent> history;
+        std::vector<ProfileEvent> captured;
+        std::filesystem::path capturePath;
+        u64 captureStart = 0;
+        u64 captureEnd = 0;
+
+        static ThreadBuffer& LocalBuffer();
+
+        void Collect();
+
+        void WriteCapture();
+    };
+
+    class ProfileScope
+    {
+    public:
+        explicit ProfileScope(const char* name) : name(name), depth(Profiler::Enter()), start(Profiler::NowNs())
+        {
+        }
+
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+
+        ~ProfileScope()
+        {
+            Profiler::Leave(name, start, depth);
+        }
+
+    private:
+        const char* name;
+        u32 depth;
+        u64 start;
+    };
+
+    // work submitted from another thread is recorded under the submitter's frame while it runs
+    class ProfileFrameScope
+    {
+    public:
+        explicit ProfileFrameScope(u64 frame) : previous(Profiler::CurrentFrame())
+        {
+            Profiler::SetCurrentFrame(frame);
+        }
+
+        ProfileFrameScope(const ProfileFrameScope&) = delete;
+        ProfileFrameScope& operator=(const ProfileFrameScope&) = delete;
+
+        ~ProfileFrameScope()
+        {
+            Profiler::SetCurrentFrame(previous);
+        }
+
+    private:
+        u64 previous;
+    };
+} // Ajiva
+// Core
+
+#define AJ_PROFILE_CONCAT_INNER(a, b) a##b
+#define AJ_PROFILE_CONCAT(a, b) AJ_PROFILE_CONCAT_INNER(a, b)
+
+#if AJ_PROFILING
+// name has to outlive the profiler: a literal or Profiler::Intern
+#define AJ_PROFILE_SCOPE(name) ::Ajiva::Core::ProfileScope AJ_PROFILE_CONCAT(ajProfileScope, __LINE__)(name)
+#define AJ_PROFILE_FUNCTION() AJ_PROFILE_SCOPE(__func__)
+#define AJ_PROFILE_FRAME(frame) ::Ajiva::Core::ProfileFrameScope AJ_PROFILE_CONCAT(ajProfileFrame, __LINE__)(frame)
+#define AJ_PROFILE_CURRENT_FRAME() ::Ajiva::Core::Profiler::CurrentFrame()
+#define AJ_PROFILE_BEGIN_FRAME() ::Ajiva::Core::Profiler::Get().BeginFrame()
+#define AJ_PROFILE_END_FRAME() ::Ajiva::Core::Profiler::Get().EndFrame()
+#else
+#define AJ_PROFILE_SCOPE(name) ((void)0)
+#define AJ_PROFILE_FUNCTION() ((void)0)
+#define AJ_PROFILE_FRAME(frame) ((void)0)
+#define AJ_PROFILE_CURRENT_FRAME() (0ull)
+#define AJ_PROFILE_BEGIN_FRAME() ((void)0)
+#define AJ_PROFILE_END_FRAME() ((void)0)
+#endif
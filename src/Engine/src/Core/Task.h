@@ -0,0 +1,282 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#pragma once
+
+#include "defines.h"
+#include "Core/ThreadPool.h"
+#include "Core/MainThreadDispatcher.h"
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace Ajiva::Core
+{
+    template <typename T = void>
+    class Task;
+
+    namespace Detail
+    {
+        struct TaskPromiseBase
+        {
+            std::coroutine_handle<> continuation;
+            std::exception_ptr exception;
+            bool detached = false;
+
+            struct FinalAwaiter
+            {
+                bool await_ready() const noexcept
+                {
+                    return false;
+                }
+
+                template <typename Promise>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+                {
+                    auto& promise = handle.promise();
+                    if (promise.detached)
+                    {
+                        if (promise.exception)
+                        {
+                            try
+                            {
+                                std::rethrow_exception(promise.exception);
+                            }
+                            catch (const std::exception& e)
+                            {
+                                PLOG_ERROR << "Detached task failed: " << e.what();
+                            }
+                            catch (...)
+                            {
+                                PLOG_ERROR << "Detached task failed";
+                            }
+                        }
+                        handle.destroy();
+                        return std::noop_coroutine();
+                    }
+                    // symmetric transfer, the awaiting coroutine continues on the thread that finished us
+                    return promise.continuation ? promise.continuation : std::noop_coroutine();
+                }
+
+                void await_resume() const noexcept
+                {
+                }
+            };
+
+            // lazy: the body starts when the task is awaited or detached, so the continuation is always set first
+            std::suspend_always initial_suspend() const noexcept
+            {
+                return {};
+            }
+
+            FinalAwaiter final_suspend() const noexcept
+            {
+                return {};
+            }
+
+            void unhandled_exception() noexcept
+            {
+                exception = std::current_exception();
+            }
+        };
+
+        template <typename T>
+        struct TaskPromise : TaskPromiseBase
+        {
+            std::optional<T> value;
+
+            Task<T> get_return_object() noexcept;
+
+            template <typename U>
+            void return_value(U&& result)
+            {
+                value.emplace(std::forward<U>(result));
+            }
+
+            T Result()
+            {
+                if (exception) std::rethrow_exception(exception);
+                return std::move(*value);
+            }
+        };
+
+        template <>
+        struct TaskPromise<void> : TaskPromiseBase
+        {
+            Task<void> get_return_object() noexcept;
+
+            void return_void() const noexcept
+            {
+            }
+
+            void Result() const
+            {
+                if (exception) std::rethrow_exception(exception);
+            }
+        };
+    }
+
+    // Coroutine result type. Nothing runs until the task is co_awaited or detached, the awaiting coroutine
+    // resumes on whatever thread the task finished on. Exceptions are rethrown from co_await.
+    template <typename T>
+    class Task
+    {
+    public:
+        using promise_type = Detail::TaskPromise<T>;
+
+        Task() = default;
+
+        explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle)
+        {
+        }
+
+        Task(Task&& other) noexcept : handle(std::exchange(other.handle, nullptr))
+        {
+        }
+
+        Task& operator=(Task&& other) noexcept
+        {
+            if (this != &other)
+            {
+                if (handle) handle.destroy();
+                handle = std::exchange(other.handle, nullptr);
+            }
+            return *this;
+        }
+
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+
+        ~Task()
+        {
+            if (handle) handle.destroy();
+        }
+
+        [[nodiscard]] bool IsReady() const
+        {
+            return !handle || handle.done();
+        }
+
+        // starts the task without anyone waiting for it, the frame frees itself when the body finished
+        void Detach() &&
+        {
+            if (!handle) return;
+            auto started = std::exchange(handle, nullptr);
+            started.promise().detached = true;
+            started.resume();
+        }
+
+        auto operator co_await() && noexcept
+        {
+            struct Awaiter
+            {
+                std::coroutine_handle<promise_type> handle;
+
+                bool await_ready() const noexcept
+                {
+                    return !handle || handle.done();
+                }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+                {
+                    handle.promise().continuation = awaiting;
+                    return handle;
+                }
+
+                T await_resume()
+                {
+                    return handle.promise().Result();
+                }
+            };
+            return Awaiter{handle};
+        }
+
+    private:
+        std::coroutine_handle<promise_type> handle;
+    };
+
+    namespace Detail
+    {
+        template <typename T>
+        Task<T> TaskPromise<T>::get_return_object() noexcept
+        {
+            return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+        }
+
+        inline Task<void> TaskPromise<void>::get_return_object() noexcept
+        {
+            return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+        }
+    }
+
+    // what the awaiters below queue, the coroutine frame holds everything else
+    struct ResumeCoroutine
+    {
+        std::coroutine_handle<> handle;
+
+        void operator()() const
+        {
+            handle.resume();
+        }
+    };
+
+    static_assert(TaskFunction::FitsInline<ResumeCoroutine>, "resuming a coroutine must not allocate");
+
+    // co_await ResumeOn(pool, priority): continue on a pool worker. No hop when we already run on a worker with
+    // the same priority, runs inline when the pool has no workers or refuses the work during shutdown.
+    struct PoolAwaiter
+    {
+        IThreadPool* pool;
+        WorkPriority priority;
+
+        bool await_ready() const
+        {
+            if (!pool || pool->WorkerCount() == 0) return true;
+            return pool->IsWorkerThread() && pool->CurrentPriority() == priority;
+        }
+
+        // a refused hop resumes right here, the frame would otherwise stay suspended forever
+        bool await_suspend(std::coroutine_handle<> handle) const
+        {
+            return pool->QueueWork(ResumeCoroutine{handle}, nullptr, priority);
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+    };
+
+    // co_await ResumeOn(dispatcher): continue inside the next Drain on the main thread, no hop if already there
+    struct MainThreadAwaiter
+    {
+        MainThreadDispatcher* dispatcher;
+
+        bool await_ready() const
+        {
+            return !dispatcher || dispatcher->IsMainThread();
+        }
+
+        void await_suspend(std::coroutine_handle<> handle) const
+        {
+            dispatcher->Post(ResumeCoroutine{handle});
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+    };
+
+    AJ_INLINE PoolAwaiter ResumeOn(IThreadPool& pool, WorkPriority priority = WorkPriority::Interactive)
+    {
+        return {&pool, priority};
+    }
+
+    AJ_INLINE MainThreadAwaiter ResumeOn(MainThreadDispatcher& dispatcher)
+    {
+        return {&dispatcher};
+    }
+} // Ajiva
+// Core
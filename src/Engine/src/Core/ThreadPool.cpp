@@ -3,9 +3,629 @@
 //
 
 #include "ThreadPool.h"
+#include "Core/Profiler.h"
 
+#include <algorithm>
+#include <chrono>
+
+#ifdef AJ_PLATFORM_WINDOWS
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(AJ_PLATFORM_LINUX)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(AJ_PLATFORM_APPLE)
+#include <pthread.h>
+#endif
 
 namespace Ajiva::Core
 {
+    thread_local ThreadPool::Worker* ThreadPool::currentWorker = nullptr;
+
+    static u64 NowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static u64 LaneOf(WorkPriority priority)
+    {
+        return static_cast<u64>(priority);
+    }
+
+    constexpr u64 BackgroundLane = static_cast<u64>(WorkPriority::Background);
+
+    static u32 ResolveWorkerCount(const ThreadPoolConfig& config)
+    {
+        if (config.WorkerCount > 0)
+            return config.WorkerCount;
+        const u32 hardware = std::max(1u, std::thread::hardware_concurrency());
+        return hardware > config.ReservedCores ? hardware - config.ReservedCores : 1;
+    }
+
+    ThreadPool::ThreadPool(const ThreadPoolConfig& config, bool start)
+        : config(config), nodes(this), startNs(NowNs())
+    {
+        for (auto& lane : injection)
+        {
+            lane = CreateScope<MpmcQueue<WorkNode*>>(config.QueueCapacity);
+        }
+        const u32 count = ResolveWorkerCount(config);
+        backgroundLimit = config.MaxBackgroundWorkers > 0
+                              ? std::min(config.MaxBackgroundWorkers, count)
+                              : std::max(1u, count / 2);
+        workers.reserve(count);
+        for (u64 i = 0; i < count; ++i)
+        {
+            workers.push_back(CreateScope<Worker>(this, i, config.QueueCapacity));
+        }
+        PLOG_INFO << "ThreadPool " << config.Name << ": " << count << " workers (" << backgroundLimit
+                  << " background), queue " << config.QueueCapacity << (config.PinThreads ? ", pinned" : "");
+        if (start)
+        {
+            Start();
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        Shutdown();
+    }
+
+    void ThreadPool::Start()
+    {
+        if (started) return;
+        started = true;
+        for (auto& worker : workers)
+        {
+            auto state = worker.get();
+            state->thread = std::thread([state]()
+            {
+                state->pool->WorkerLoop(state);
+            });
+        }
+    }
+
+    void ThreadPool::Shutdown()
+    {
+        if (shutdown.exchange(true)) return;
+        {
+            std::lock_guard<std::mutex> lock(parkMutex);
+            parkCv.notify_all();
+        }
+        {
+            std::lock_guard<std::mutex> lock(spaceMutex);
+            spaceCv.notify_all();
+        }
+        for (auto& worker : workers)
+        {
+            if (worker->thread.joinable())
+            {
+                worker->thread.join();
+            }
+        }
+        // queued work is dropped, same as before
+        WorkNode* work;
+        for (u64 lane = 0; lane < WorkPriorityCount; ++lane)
+        {
+            while (injection[lane]->TryPop(work))
+            {
+                Drop(work);
+            }
+            for (auto& worker : workers)
+            {
+                while ((work = worker->deques[lane]->Pop()))
+                {
+                    Drop(work);
+                }
+            }
+        }
+    }
+
+    bool ThreadPool::QueueWork(TaskFunction func, TaskFunction callback, WorkPriority priority)
+    {
+        if (shutdown) return false;
+        auto work = AllocateNode(std::move(func), std::move(callback));
+        work->priority = priority;
+        work->refs.store(1, std::memory_order_relaxed);
+        return Schedule(work);
+    }
+
+    WorkHandle ThreadPool::Submit(TaskFunction func, const WorkHandle* dependencies, u64 count,
+                                  WorkPriority priority)
+    {
+        if (shutdown) return {};
+        auto work = AllocateNode(std::move(func), nullptr);
+        work->priority = priority;
+        work->refs.store(1, std::memory_order_relaxed); // released after execution
+        WorkHandle handle(work);
+
+        // the extra pending count keeps predecessors from scheduling us before all edges are linked
+        work->pending.store(1, std::memory_order_relaxed);
+        nodes.ReserveEdges(work, count);
+        for (u64 i = 0; i < count; ++i)
+        {
+            auto dependency = dependencies[i].Node();
+            if (!dependency) continue;
+            auto edge = work->EdgeAt(i, count);
+            edge->successor = work;
+            work->pending.fetch_add(1, std::memory_order_relaxed);
+            if (!dependency->AddSuccessor(edge))
+            {
+                work->pending.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+        if (work->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            Schedule(work);
+        }
+        return handle;
+    }
+
+    bool ThreadPool::TryRunPending()
+    {
+        WorkNode* work = nullptr;
+        auto self = currentWorker;
+        if (self && self->pool == this)
+        {
+            work = FindWork(self);
+        }
+        else
+        {
+            // a thread outside the pool is most likely the frame, it must not get stuck in background work
+            for (u64 lane = 0; lane < BackgroundLane && !work; ++lane)
+            {
+                if (injection[lane]->TryPop(work))
+                    break;
+                for (auto& worker : workers)
+                {
+                    if ((work = worker->deques[lane]->Steal()))
+                        break;
+                }
+            }
+        }
+        if (!work)
+            return false;
+        Execute(work);
+        return true;
+    }
+
+    bool ThreadPool::IsWorkerThread()
+    {
+        return currentWorker && currentWorker->pool == this;
+    }
+
+    u64 ThreadPool::WorkerCount()
+    {
+        return workers.size();
+    }
+
+    WorkPriority ThreadPool::CurrentPriority()
+    {
+        auto self = currentWorker;
+        return self && self->pool == this ? self->running : WorkPriority::FrameCritical;
+    }
+
+    WorkLaneStats ThreadPool::GetLaneStats(WorkPriority priority)
+    {
+        const u64 lane = LaneOf(priority);
+        HistogramSnapshot latency = external.queueLatency[lane].Snapshot();
+        for (auto& worker : workers)
+        {
+            latency.Merge(worker->telemetry.queueLatency[lane].Snapshot());
+        }
+        WorkLaneStats stats;
+        stats.Queued = std::max<i64>(0, lanes[lane].queued.load(std::memory_order_relaxed));
+        stats.Executed = latency.Count;
+        stats.AverageLatencyMs = latency.AverageMs();
+        stats.MaxLatencyMs = latency.MaxMs();
+        return stats;
+    }
+
+    ThreadPoolStats ThreadPool::GetStats()
+    {
+        ThreadPoolStats stats;
+        for (u64 lane = 0; lane < WorkPriorityCount; ++lane)
+        {
+            stats.QueueLatency[lane] = external.queueLatency[lane].Snapshot();
+        }
+        stats.Execution = external.execution.Snapshot();
+        stats.WorkerBusyMs.reserve(workers.size());
+        for (auto& worker : workers)
+        {
+            auto& telemetry = worker->telemetry;
+            for (u64 lane = 0; lane < WorkPriorityCount; ++lane)
+            {
+                stats.QueueLatency[lane].Merge(telemetry.queueLatency[lane].Snapshot());
+            }
+            stats.Execution.Merge(telemetry.execution.Snapshot());
+            stats.WorkerBusyMs.push_back(static_cast<f64>(telemetry.busyNs.load(std::memory_order_relaxed)) / 1e6);
+        }
+        stats.Queued = std::max<i64>(0, queued.load(std::memory_order_relaxed));
+        stats.QueuedHighWater = std::max<i64>(0, queuedHighWater.load(std::memory_order_relaxed));
+        stats.Active = std::max<i64>(0, active.load(std::memory_order_relaxed));
+        stats.UptimeMs = static_cast<f64>(NowNs() - startNs) / 1e6;
+        stats.BlockedProducerCount = blockedProducerCount.load(std::memory_order_relaxed);
+        stats.BlockedProducerMs = static_cast<f64>(blockedProducerNs.load(std::memory_order_relaxed)) / 1e6;
+        return stats;
+    }
+
+    void ThreadPool::WorkerLoop(Worker* self)
+    {
+        SetupWorkerThread(self);
+        PLOG_DEBUG << "WorkerLoop: " << self->index;
+        currentWorker = self;
+        u32 idle = 0;
+        while (!shutdown.load(std::memory_order_relaxed))
+        {
+            if (auto work = FindWork(self))
+            {
+                Execute(work);
+                idle = 0;
+                continue;
+            }
+            if (++idle < AJ_THREAD_POOL_SPIN_COUNT)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            Park();
+            idle = 0;
+        }
+        currentWorker = nullptr;
+        PLOG_DEBUG << "WorkerLoop: " << self->index << " end";
+    }
+
+    void ThreadPool::SetupWorkerThread(Worker* self)
+    {
+        const std::string name = config.Name + " " + std::to_string(self->index);
+        const u32 hardware = std::max(1u, std::thread::hardware_concurrency());
+        const u64 core = (config.ReservedCores + self->index) % hardware;
+#ifdef AJ_PLATFORM_WINDOWS
+        const std::wstring wideName(name.begin(), name.end());
+        SetThreadDescription(GetCurrentThread(), wideName.c_str());
+        if (config.PinThreads && core < 64)
+        {
+            if (!SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << core))
+            {
+                PLOG_WARNING << "Failed to pin " << name << " to core " << core;
+            }
+        }
+#elif defined(AJ_PLATFORM_LINUX)
+        // linux limits thread names to 15 characters
+        pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+        if (config.PinThreads)
+        {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(core, &set);
+            if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+            {
+                PLOG_WARNING << "Failed to pin " << name << " to core " << core;
+            }
+        }
+#elif defined(AJ_PLATFORM_APPLE)
+        pthread_setname_np(name.c_str());
+        if (config.PinThreads)
+        {
+            PLOG_WARNING << "Thread pinning is not supported on this platform";
+        }
+#endif
+#if AJ_PROFILING
+        Profiler::SetThreadName(name);
+#endif
+        (void)core;
+    }
+
+    WorkNode* ThreadPool::FindWork(Worker* self)
+    {
+        for (u64 lane = 0; lane < WorkPriorityCount; ++lane)
+        {
+            if (lane == BackgroundLane && self->backgroundDepth == 0)
+            {
+                // the slot is kept while the node runs, Execute gives it back
+                if (!TryAcquireBackground())
+                    continue;
+                auto work = TakeFromLane(self, lane);
+                if (!work)
+                {
+                    backgroundRunning.fetch_sub(1, std::memory_order_seq_cst);
+                }
+                return work;
+            }
+            if (auto work = TakeFromLane(self, lane))
+                return work;
+        }
+        return nullptr;
+    }
+
+    WorkNode* ThreadPool::TakeFromLane(Worker* self, u64 lane)
+    {
+        if (auto work = self->deques[lane]->Pop())
+            return work;
+
+        WorkNode* work;
+        if (injection[lane]->TryPop(work))
+        {
+            if (blockedProducers.load(std::memory_order_seq_cst) > 0)
+            {
+                std::lock_guard<std::mutex> lock(spaceMutex);
+                spaceCv.notify_all();
+            }
+            return work;
+        }
+
+        // xorshift to spread thieves over the victims
+        self->seed ^= self->seed << 13;
+        self->seed ^= self->seed >> 7;
+        self->seed ^= self->seed << 17;
+        const u64 count = workers.size();
+        const u64 start = self->seed % count;
+        for (u64 i = 0; i < count; ++i)
+        {
+            auto victim = workers[(start + i) % count].get();
+            if (victim == self) continue;
+            if (auto stolen = victim->deques[lane]->Steal())
+                return stolen;
+        }
+        return nullptr;
+    }
+
+    bool ThreadPool::TryAcquireBackground()
+    {
+        if (lanes[BackgroundLane].queued.load(std::memory_order_relaxed) <= 0)
+            return false;
+        u32 running = backgroundRunning.load(std::memory_order_relaxed);
+        do
+        {
+            if (running >= backgroundLimit)
+                return false;
+        }
+        while (!backgroundRunning.compare_exchange_weak(running, running + 1, std::memory_order_seq_cst));
+        return true;
+    }
+
+    void ThreadPool::ReleaseBackground()
+    {
+        backgroundRunning.fetch_sub(1, std::memory_order_seq_cst);
+        // a worker may have parked because the throttle hid the remaining background work
+        if (lanes[BackgroundLane].queued.load(std::memory_order_seq_cst) > 0)
+        {
+            WakeOne();
+        }
+    }
+
+    i64 ThreadPool::RunnableCount()
+    {
+        i64 runnable = 0;
+        for (u64 lane = 0; lane < BackgroundLane; ++lane)
+        {
+            runnable += lanes[lane].queued.load(std::memory_order_seq_cst);
+        }
+        if (backgroundRunning.load(std::memory_order_seq_cst) < backgroundLimit)
+        {
+            runnable += lanes[BackgroundLane].queued.load(std::memory_order_seq_cst);
+        }
+        return runnable;
+    }
+
+    bool ThreadPool::Schedule(WorkNode* work)
+    {
+        const u64 lane = LaneOf(work->priority);
+        work->enqueueTicks = NowNs();
+        lanes[lane].queued.fetch_add(1, std::memory_order_relaxed);
+        const i64 depth = queued.fetch_add(1, std::memory_order_relaxed) + 1;
+        i64 highWater = queuedHighWater.load(std::memory_order_relaxed);
+        while (depth > highWater && !queuedHighWater.compare_exchange_weak(highWater, depth,
+                                                                           std::memory_order_relaxed))
+        {
+        }
+
+        auto self = currentWorker;
+        if (self && self->pool == this)
+        {
+            // nested submission, stays local until someone steals it
+            if (!self->deques[lane]->Push(work) && !injection[lane]->TryPush(work))
+            {
+                // everything is full, blocking here could deadlock the pool
+                if (lane == BackgroundLane && self->backgroundDepth == 0)
+                {
+                    backgroundRunning.fetch_add(1, std::memory_order_seq_cst);
+                }
+                Execute(work);
+                return true;
+            }
+        }
+        else
+        {
+            if (!injection[lane]->TryPush(work))
+            {
+                const u64 blockedSince = NowNs();
+                blockedProducerCount.fetch_add(1, std::memory_order_relaxed);
+                do
+                {
+                    WaitForSpace(lane);
+                    if (shutdown)
+                    {
+                        lanes[lane].queued.fetch_sub(1, std::memory_order_relaxed);
+                        queued.fetch_sub(1, std::memory_order_relaxed);
+                        Drop(work);
+                        return false;
+                    }
+                }
+                while (!injection[lane]->TryPush(work));
+                blockedProducerNs.fetch_add(NowNs() - blockedSince, std::memory_order_relaxed);
+            }
+        }
+        WakeOne();
+        return true;
+    }
+
+    ThreadPool::Telemetry& ThreadPool::LocalTelemetry()
+    {
+        auto self = currentWorker;
+        return self && self->pool == this ? self->telemetry : external;
+    }
+
+    void ThreadPool::Execute(WorkNode* work)
+    {
+        const u64 lane = LaneOf(work->priority);
+        lanes[lane].queued.fetch_sub(1, std::memory_order_relaxed);
+        queued.fetch_sub(1, std::memory_order_relaxed);
+
+        auto& telemetry = LocalTelemetry();
+        const u64 begin = NowNs();
+        telemetry.queueLatency[lane].Record(begin > work->enqueueTicks ? begin - work->enqueueTicks : 0);
+
+        auto self = currentWorker && currentWorker->pool == this ? currentWorker : nullptr;
+        const bool background = work->priority == WorkPriority::Background;
+        WorkPriority previous = WorkPriority::FrameCritical;
+        if (self)
+        {
+            previous = self->running;
+            self->running = work->priority;
+            ++self->executeDepth;
+            if (background)
+                ++self->backgroundDepth;
+        }
+
+        active.fetch_add(1, std::memory_order_relaxed);
+        work->status.store(static_cast<u32>(WorkStatus::Running), std::memory_order_relaxed);
+        {
+            static constexpr const char* ProfileNames[WorkPriorityCount] = {
+                "Task: frame", "Task: interactive", "Task: background"
+            };
+            AJ_PROFILE_FRAME(work->frame);
+            AJ_PROFILE_SCOPE(ProfileNames[lane]);
+            if (work->func)
+            {
+                work->func();
+                work->func = nullptr; // drop captures now, handles may keep the node alive for a while
+            }
+            active.fetch_sub(1, std::memory_order_relaxed);
+            if (work->callback)
+            {
+                work->callback();
+                work->callback = nullptr;
+            }
+        }
+
+        const u64 elapsed = NowNs() - begin;
+        telemetry.execution.Record(elapsed);
+        if (!self || self->executeDepth == 1)
+        {
+            telemetry.busyNs.fetch_add(elapsed, std::memory_order_relaxed);
+        }
+
+        if (self)
+        {
+            self->running = previous;
+            --self->executeDepth;
+            if (background && --self->backgroundDepth == 0)
+            {
+                ReleaseBackground();
+            }
+        }
+        Finish(work);
+    }
+
+    void ThreadPool::Finish(WorkNode* work)
+    {
+        auto edge = work->Complete();
+        while (edge && edge != WorkNode::Closed)
+        {
+            // read next first, the successor may run and be released right after the decrement
+            auto next = edge->next;
+            auto successor = edge->successor;
+            if (successor->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                Schedule(successor);
+            }
+            edge = next;
+        }
+        Release(work);
+    }
+
+    // completes without running, successors still fire so waiters do not hang
+    void ThreadPool::Drop(WorkNode* work)
+    {
+        work->func = nullptr;
+        work->callback = nullptr;
+        auto edge = work->Complete();
+        while (edge && edge != WorkNode::Closed)
+        {
+            auto next = edge->next;
+            auto successor = edge->successor;
+            if (successor->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                Drop(successor);
+            }
+            edge = next;
+        }
+        Release(work);
+    }
+
+    WorkNode* ThreadPool::AllocateNode(TaskFunction&& func, TaskFunction&& callback)
+    {
+        auto work = nodes.Acquire(LocalNodeCache());
+        work->func = std::move(func);
+        work->callback = std::move(callback);
+        work->frame = AJ_PROFILE_CURRENT_FRAME();
+        return work;
+    }
+
+    WorkNodePool::Cache* ThreadPool::LocalNodeCache()
+    {
+        auto self = currentWorker;
+        return self && self->pool == this ? &self->nodeCache : nullptr;
+    }
+
+    void ThreadPool::Release(WorkNode* work)
+    {
+        if (work->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            ReleaseNode(work);
+        }
+    }
+
+    void ThreadPool::ReleaseNode(WorkNode* work)
+    {
+        nodes.Release(LocalNodeCache(), work);
+    }
+
+    void ThreadPool::Park()
+    {
+        std::unique_lock<std::mutex> lock(parkMutex);
+        sleepers.fetch_add(1, std::memory_order_seq_cst);
+        // re-check after announcing, a producer either sees us sleeping or we see its work
+        if (RunnableCount() == 0 && !shutdown)
+        {
+            parkCv.wait(lock);
+        }
+        sleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void ThreadPool::WakeOne()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers.load(std::memory_order_seq_cst) > 0)
+        {
+            std::lock_guard<std::mutex> lock(parkMutex);
+            parkCv.notify_one();
+        }
+    }
+
+    void ThreadPool::WaitForSpace(u64 lane)
+    {
+        std::unique_lock<std::mutex> lock(spaceMutex);
+        blockedProducers.fetch_add(1, std::memory_order_seq_cst);
+        if (injection[lane]->IsFull() && !shutdown)
+        {
+            // the timeout guards against a missed notify, the pop side only checks relaxed positions
+            spaceCv.wait_for(lock, std::chrono::milliseconds(1));
+        }
+        blockedProducers.fetch_sub(1, std::memory_order_relaxed);
+    }
 } // Ajiva
 // Core
@@ -5,178 +5,305 @@
 #pragma once
 
 #include "defines.h"
+#include "Core/WorkStealingDeque.h"
+#include "Core/MpmcQueue.h"
+#include "Core/Work.h"
+#include "Core/Histogram.h"
 
-#include <functional>
 #include <memory>
 #include <thread>
 #include <vector>
-#include <future>
-#include <queue>
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
+#include <string>
 
 #ifndef AJ_THREAD_POOL_LENGTH
 #define AJ_THREAD_POOL_LENGTH 1024
 #endif
 
+#ifndef AJ_THREAD_POOL_SPIN_COUNT
+#define AJ_THREAD_POOL_SPIN_COUNT 64
+#endif
+
 namespace Ajiva::Core
 {
-    class AJ_API IThreadPool
+    struct WorkLaneStats
     {
-    public:
-        virtual void QueueWork(const std::function<void()>& func, const std::function<void()>& callback = nullptr) = 0;
-
-        AJ_INLINE virtual bool IsWorking() = 0;
-
-        AJ_INLINE virtual bool IsFull() = 0;
-
-        AJ_INLINE virtual bool IsEmpty() = 0;
+        u64 Queued = 0; // waiting right now
+        u64 Executed = 0;
+        f64 AverageLatencyMs = 0; // enqueue -> start
+        f64 MaxLatencyMs = 0;
     };
 
-    template <u64 N = AJ_THREAD_POOL_LENGTH, u64 T = 8>
-    class AJ_API ThreadPool : public IThreadPool
+    struct ThreadPoolStats
     {
-        struct Worker
-        {
-            ThreadPool* pool;
-            std::thread thread;
-            u64 index = 0;
-            bool working = false;
-        };
+        HistogramSnapshot QueueLatency[WorkPriorityCount]; // enqueue -> start, per lane
+        HistogramSnapshot Execution;
+        u64 Queued = 0;
+        u64 QueuedHighWater = 0;
+        u64 Active = 0;
+        f64 UptimeMs = 0;
+        std::vector<f64> WorkerBusyMs;
+        u64 BlockedProducerCount = 0; // pushes that found the injection queue full
+        f64 BlockedProducerMs = 0;
 
-        struct Work
+        // busy share of a worker between two snapshots, 0..1
+        [[nodiscard]] f64 Utilization(const ThreadPoolStats& previous, u64 worker) const
         {
-            std::function<void()> func;
-            std::function<void()> callback;
-        };
+            const f64 wall = UptimeMs - previous.UptimeMs;
+            if (wall <= 0 || worker >= WorkerBusyMs.size() || worker >= previous.WorkerBusyMs.size())
+                return 0;
+            const f64 busy = (WorkerBusyMs[worker] - previous.WorkerBusyMs[worker]) / wall;
+            return busy < 0 ? 0 : busy > 1 ? 1 : busy;
+        }
+    };
+
+    class AJ_API IThreadPool
+    {
+        friend class WorkHandle;
 
     public:
-        ThreadPool() : ThreadPool(true)
+        virtual ~IThreadPool() = default;
+
+        // false when the pool is shutting down and did not take the work, func and callback never run then
+        virtual bool QueueWork(TaskFunction func, TaskFunction callback = nullptr,
+                               WorkPriority priority = WorkPriority::Interactive) = 0;
+
+        // schedules func once all dependencies completed, invalid handles are ignored
+        virtual WorkHandle Submit(TaskFunction func, const WorkHandle* dependencies, u64 count,
+                                  WorkPriority priority) = 0;
+
+        WorkHandle Submit(TaskFunction func, WorkPriority priority = WorkPriority::Interactive)
         {
+            return Submit(std::move(func), nullptr, 0, priority);
         }
 
-        explicit ThreadPool(bool start)
+        WorkHandle Submit(TaskFunction func, std::initializer_list<WorkHandle> dependencies,
+                          WorkPriority priority = WorkPriority::Interactive)
         {
-            head = 0;
-            tail = 0;
-            shutdown = false;
-            started = false;
-            waitFunc = [this]() { return !IsEmpty() || shutdown; };
-            if (start)
-            {
-                Start();
-            }
+            return Submit(std::move(func), dependencies.begin(), dependencies.size(), priority);
         }
 
-        void Start()
+        WorkHandle Submit(TaskFunction func, const std::vector<WorkHandle>& dependencies,
+                          WorkPriority priority = WorkPriority::Interactive)
         {
-            if (started) return;
-            started = true;
-            for (u64 i = 0; i < T; ++i)
-            {
-                auto state = &states[i];
-                state->pool = this;
-                state->index = i;
-                state->working = false;
-                state->thread = std::thread([state]()
-                {
-                    state->pool->WorkerLoop(state);
-                });
-            }
+            return Submit(std::move(func), dependencies.data(), dependencies.size(), priority);
         }
 
-        ~ThreadPool()
+        WorkHandle Then(const WorkHandle& before, TaskFunction func, WorkPriority priority = WorkPriority::Interactive)
         {
-            Shutdown();
+            return Submit(std::move(func), &before, 1, priority);
         }
 
-        void Shutdown()
+        // fan-in join, completes once every handle completed
+        WorkHandle WhenAll(const std::vector<WorkHandle>& handles)
         {
-            if (shutdown) return;
-            {
-                std::unique_lock<std::mutex> lock(mutex);
-                shutdown = true;
-            }
-            cv.notify_all();
-            for (u64 i = 0; i < T; ++i)
-            {
-                auto state = &states[i];
-                if (state->thread.joinable())
-                {
-                    state->thread.join();
-                }
-            }
+            return Submit(nullptr, handles.data(), handles.size(), WorkPriority::FrameCritical);
         }
 
-        void WorkerLoop(ThreadPool::Worker* state)
+        // runs one queued item on the calling thread, false if nothing was found
+        // threads outside the pool never pick up background work here
+        virtual bool TryRunPending() = 0;
+
+        virtual bool IsWorkerThread() = 0;
+
+        virtual u64 WorkerCount() = 0;
+
+        // priority of the task running on this thread, FrameCritical outside the pool (the caller blocks a frame)
+        virtual WorkPriority CurrentPriority() = 0;
+
+        [[nodiscard]] virtual WorkLaneStats GetLaneStats(WorkPriority priority) = 0;
+
+        // cumulative since start, cheap enough to call every frame
+        [[nodiscard]] virtual ThreadPoolStats GetStats() = 0;
+
+        AJ_INLINE virtual bool IsWorking() = 0;
+
+        AJ_INLINE virtual bool IsFull() = 0;
+
+        AJ_INLINE virtual bool IsEmpty() = 0;
+
+    protected:
+        virtual void ReleaseNode(WorkNode* node) = 0;
+    };
+
+    struct ThreadPoolConfig
+    {
+        u32 WorkerCount = 0; // 0: one worker per hardware thread that is not reserved
+        u32 ReservedCores = 1; // left to the main/render thread
+        bool PinThreads = false; // worker i runs on core ReservedCores + i
+        u64 QueueCapacity = AJ_THREAD_POOL_LENGTH; // injection queue and each worker deque per lane, power of two
+        u32 MaxBackgroundWorkers = 0; // workers allowed to run background work at once, 0: half of them
+        std::string Name = "Worker";
+    };
+
+    // Work stealing pool: every worker owns a Chase-Lev deque per priority lane, external producers go through a
+    // lock-free injection queue per lane. Idle workers check lanes from high to low priority (own deque, injection,
+    // steal) before they park. Only MaxBackgroundWorkers may run background work at once, the rest stays free for
+    // frame critical work.
+    class AJ_API ThreadPool : public IThreadPool
+    {
+        // written by one thread (a worker, or any thread for the shared external block), read by GetStats
+        struct Telemetry
         {
-            PLOG_DEBUG << "WorkerLoop: " << state->index;
-            while (!shutdown)
+            AtomicLogHistogram queueLatency[WorkPriorityCount];
+            AtomicLogHistogram execution;
+            std::atomic<u64> busyNs{0};
+        };
+
+        struct Worker
+        {
+            explicit Worker(ThreadPool* pool, u64 index, u64 capacity) : pool(pool), index(index), seed(index + 1)
             {
-                Work work;
-                {
-                    if (shutdown) break;
-                    std::unique_lock<std::mutex> lock(mutex);
-                    cv.wait(lock, waitFunc);
-                    if (shutdown) break;
-                    auto i = this->tail++;
-                    work = std::move(works[i]);
-                    state->working = true;
-                }
-                work.func();
-                state->working = false;
-                if (work.callback)
+                for (auto& deque : deques)
                 {
-                    work.callback();
+                    deque = CreateScope<WorkStealingDeque<WorkNode>>(capacity);
                 }
             }
-            PLOG_DEBUG << "WorkerLoop: " << state->index << " end";
-        }
 
-        void QueueWork(const std::function<void()>& func, const std::function<void()>& callback = nullptr) override
-        {
-            if (shutdown) return;
-            std::unique_lock<std::mutex> lock(mutex);
-            if (shutdown) return;
-            while (IsFull())
-            {
-                cv.wait(lock, [this]() { return !IsFull() || shutdown; });
-            }
-            auto i = this->head++;
-            works[i].func = func;
-            works[i].callback = callback;
-            PLOG_DEBUG << "QueueWork: " << i << " " << head << " " << tail;
-            cv.notify_one();
-        }
+            ThreadPool* pool;
+            u64 index = 0;
+            std::thread thread;
+            Scope<WorkStealingDeque<WorkNode>> deques[WorkPriorityCount];
+            WorkNodePool::Cache nodeCache;
+            u64 seed;
+            u32 backgroundDepth = 0; // > 0 while executing background work, nested background work is not throttled
+            u32 executeDepth = 0; // nested Execute through Wait, only the outermost counts as busy time
+            WorkPriority running = WorkPriority::FrameCritical;
+            Telemetry telemetry;
+        };
+
+    public:
+        using IThreadPool::Submit;
+
+        explicit ThreadPool(const ThreadPoolConfig& config = {}, bool start = true);
+
+        ~ThreadPool() override;
+
+        void Start();
+
+        void Shutdown();
+
+        bool QueueWork(TaskFunction func, TaskFunction callback = nullptr,
+                       WorkPriority priority = WorkPriority::Interactive) override;
+
+        WorkHandle Submit(TaskFunction func, const WorkHandle* dependencies, u64 count,
+                          WorkPriority priority) override;
+
+        bool TryRunPending() override;
+
+        bool IsWorkerThread() override;
+
+        u64 WorkerCount() override;
+
+        WorkPriority CurrentPriority() override;
+
+        [[nodiscard]] WorkLaneStats GetLaneStats(WorkPriority priority) override;
+
+        [[nodiscard]] ThreadPoolStats GetStats() override;
 
         AJ_INLINE bool IsWorking() override
         {
-            return tail < head;
+            return queued.load(std::memory_order_relaxed) > 0 || active.load(std::memory_order_relaxed) > 0;
         }
 
         AJ_INLINE bool IsFull() override
         {
-            return tail - head >= N;
+            for (auto& lane : injection)
+            {
+                if (lane->IsFull())
+                    return true;
+            }
+            return false;
         }
 
         AJ_INLINE bool IsEmpty() override
         {
-            return tail == head;
+            return queued.load(std::memory_order_relaxed) == 0;
+        }
+
+        [[nodiscard]] AJ_INLINE const ThreadPoolConfig& GetConfig() const
+        {
+            return config;
         }
 
     private:
-        Worker states[T];
-        Work works[N];
+        ThreadPoolConfig config;
+        std::vector<Scope<Worker>> workers;
+        Scope<MpmcQueue<WorkNode*>> injection[WorkPriorityCount];
+        WorkNodePool nodes;
+
+        std::atomic<i64> queued{0}; // queued but not started
+        std::atomic<i64> active{0}; // currently executing
+
+        struct LaneCounters
+        {
+            std::atomic<i64> queued{0};
+        };
 
-        std::atomic<u64> head; // last added index
-        std::atomic<u64> tail; // next to be processed index
+        LaneCounters lanes[WorkPriorityCount];
+        Telemetry external; // TryRunPending from threads outside the pool
+        u64 startNs = 0;
+        std::atomic<i64> queuedHighWater{0};
+        std::atomic<u64> blockedProducerCount{0};
+        std::atomic<u64> blockedProducerNs{0};
+        u32 backgroundLimit = 1;
+        std::atomic<u32> backgroundRunning{0};
 
-        bool shutdown = false;
+        std::atomic<bool> shutdown{false};
         bool started = false;
 
-        std::function<bool()> waitFunc;
-        std::mutex mutex;
-        std::condition_variable cv;
+        std::atomic<u32> sleepers{0};
+        std::mutex parkMutex;
+        std::condition_variable parkCv;
+
+        std::atomic<u32> blockedProducers{0};
+        std::mutex spaceMutex;
+        std::condition_variable spaceCv;
+
+        static thread_local Worker* currentWorker;
+
+        void WorkerLoop(Worker* self);
+
+        void SetupWorkerThread(Worker* self);
+
+        WorkNode* FindWork(Worker* self);
+
+        WorkNode* TakeFromLane(Worker* self, u64 lane);
+
+        bool TryAcquireBackground();
+
+        void ReleaseBackground();
+
+        // queued work a worker may start right now, background work only counts while a slot is free
+        i64 RunnableCount();
+
+        // false when a blocked producer gave up because of shutdown, the work was dropped
+        bool Schedule(WorkNode* work);
+
+        Telemetry& LocalTelemetry();
+
+        // runs a node that was taken from a queue, also does the queue bookkeeping
+        void Execute(WorkNode* work);
+
+        void Finish(WorkNode* work);
+
+        void Drop(WorkNode* work);
+
+        WorkNode* AllocateNode(TaskFunction&& func, TaskFunction&& callback);
+
+        WorkNodePool::Cache* LocalNodeCache();
+
+        void Release(WorkNode* work);
+
+        void ReleaseNode(WorkNode* work) override;
+
+        void Park();
+
+        void WakeOne();
+
+        void WaitForSpace(u64 lane);
     };
 } // Ajiva
 // Core
@@ -0,0 +1,226 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#include "Work.h"
+#include "Core/ThreadPool.h"
+
+#include <algorithm>
+#include <bit>
+#include <thread>
+
+namespace Ajiva::Core
+{
+    WorkEdge* WorkNode::EdgeAt(u64 index, u64 count)
+    {
+        // wider joins got their array from WorkNodePool::ReserveEdges
+        return count <= InlineEdgeCount ? &edges[index] : &overflowEdges[index];
+    }
+
+    bool WorkNode::AddSuccessor(WorkEdge* edge)
+    {
+        WorkEdge* head = successors.load(std::memory_order_acquire);
+        do
+        {
+            if (head == Closed)
+                return false;
+            edge->next = head;
+        }
+        while (!successors.compare_exchange_weak(head, edge, std::memory_order_acq_rel, std::memory_order_acquire));
+        return true;
+    }
+
+    WorkEdge* WorkNode::Complete()
+    {
+        WorkEdge* head = successors.exchange(Closed, std::memory_order_acq_rel);
+        status.store(static_cast<u32>(WorkStatus::Done), std::memory_order_release);
+        status.notify_all();
+        return head;
+    }
+
+    void WorkNode::Reset()
+    {
+        func = nullptr;
+        callback = nullptr;
+        priority = WorkPriority::Interactive;
+        enqueueTicks = 0;
+        frame = 0;
+        refs.store(0, std::memory_order_relaxed);
+        pending.store(0, std::memory_order_relaxed);
+        status.store(static_cast<u32>(WorkStatus::Pending), std::memory_order_relaxed);
+        successors.store(nullptr, std::memory_order_relaxed);
+    }
+
+    WorkNodePool::WorkNodePool(IThreadPool* owner) : owner(owner)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        Grow();
+    }
+
+    WorkNode* WorkNodePool::Acquire(Cache* cache)
+    {
+        if (cache && !cache->nodes.empty())
+        {
+            auto node = cache->nodes.back();
+            cache->nodes.pop_back();
+            return node;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (free.empty())
+        {
+            Grow();
+        }
+        if (cache)
+        {
+            // refill, so the next few acquires stay lock free
+            u64 count = std::min<u64>(BatchSize, free.size() - 1);
+            cache->nodes.insert(cache->nodes.end(), free.end() - static_cast<i64>(count), free.end());
+            free.resize(free.size() - count);
+        }
+        auto node = free.back();
+        free.pop_back();
+        return node;
+    }
+
+    void WorkNodePool::Release(Cache* cache, WorkNode* node)
+    {
+        if (node->overflowEdges)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            spareEdges.emplace_back(std::move(node->overflowEdges), node->overflowCapacity);
+            node->overflowCapacity = 0;
+        }
+        node->Reset();
+        if (cache)
+        {
+            cache->nodes.push_back(node);
+            if (cache->nodes.size() <= 2 * BatchSize)
+                return;
+            // producers on other threads allocate from the shared list, hand a batch back
+            std::lock_guard<std::mutex> lock(mutex);
+            free.insert(free.end(), cache->nodes.end() - BatchSize, cache->nodes.end());
+            cache->nodes.resize(cache->nodes.size() - BatchSize);
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        free.push_back(node);
+    }
+
+    void WorkNodePool::ReserveEdges(WorkNode* node, u64 count)
+    {
+        if (count <= WorkNode::InlineEdgeCount || node->overflowCapacity >= count) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto it = spareEdges.rbegin(); it != spareEdges.rend(); ++it)
+            {
+                if (it->second < count) continue;
+                node->overflowEdges = std::move(it->first);
+                node->overflowCapacity = it->second;
+                spareEdges.erase(std::next(it).base());
+                return;
+            }
+        }
+        // rounded up so joins of similar width share arrays
+        node->overflowCapacity = std::bit_ceil(count);
+        node->overflowEdges = std::make_unique<WorkEdge[]>(node->overflowCapacity);
+    }
+
+    u64 WorkNodePool::Capacity()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return slabs.size() * SlabSize;
+    }
+
+    void WorkNodePool::Grow()
+    {
+        auto& slab = slabs.emplace_back(std::make_unique<WorkNode[]>(SlabSize));
+        // every node can sit in the free list at once, growing here keeps Release allocation free
+        free.reserve(slabs.size() * SlabSize);
+        for (u64 i = 0; i < SlabSize; ++i)
+        {
+            slab[i].pool = owner;
+            free.push_back(&slab[i]);
+        }
+    }
+
+    WorkHandle::WorkHandle(WorkNode* node) : node(node)
+    {
+        if (node)
+            node->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    WorkHandle::WorkHandle(const WorkHandle& other) : WorkHandle(other.node)
+    {
+    }
+
+    WorkHandle::WorkHandle(WorkHandle&& other) noexcept : node(other.node)
+    {
+        other.node = nullptr;
+    }
+
+    WorkHandle& WorkHandle::operator=(const WorkHandle& other)
+    {
+        if (this != &other)
+        {
+            WorkHandle copy(other);
+            std::swap(node, copy.node);
+        }
+        return *this;
+    }
+
+    WorkHandle& WorkHandle::operator=(WorkHandle&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Reset();
+            node = other.node;
+            other.node = nullptr;
+        }
+        return *this;
+    }
+
+    WorkHandle::~WorkHandle()
+    {
+        Reset();
+    }
+
+    void WorkHandle::Reset()
+    {
+        if (!node) return;
+        if (node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            node->pool->ReleaseNode(node);
+        }
+        node = nullptr;
+    }
+
+    bool WorkHandle::IsDone() const
+    {
+        return !node || node->status.load(std::memory_order_acquire) == static_cast<u32>(WorkStatus::Done);
+    }
+
+    void WorkHandle::Wait() const
+    {
+        if (!node) return;
+        auto pool = node->pool;
+        const bool helping = pool->IsWorkerThread();
+        for (;;)
+        {
+            u32 status = node->status.load(std::memory_order_acquire);
+            if (status == static_cast<u32>(WorkStatus::Done))
+                return;
+            if (helping)
+            {
+                // never park a worker, the work we wait for might sit in our own deque
+                if (!pool->TryRunPending())
+                    std::this_thread::yield();
+            }
+            else
+            {
+                node->status.wait(status, std::memory_order_acquire);
+            }
+        }
+    }
+} // Ajiva
+// Core
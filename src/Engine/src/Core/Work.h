@@ -0,0 +1,163 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#pragma once
+
+#include "defines.h"
+#include "Core/InlineFunction.h"
+
+#include <atomic>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Ajiva::Core
+{
+    class IThreadPool;
+
+    struct WorkNode;
+
+    // one predecessor -> successor link, owned by the successor
+    struct WorkEdge
+    {
+        WorkNode* successor = nullptr;
+        WorkEdge* next = nullptr;
+    };
+
+    enum class WorkStatus : u32
+    {
+        Pending = 0,
+        Running = 1,
+        Done = 2,
+    };
+
+    // lanes are served in this order, background work is throttled by the pool
+    enum class WorkPriority : u8
+    {
+        FrameCritical = 0,
+        Interactive = 1,
+        Background = 2,
+    };
+
+    constexpr u64 WorkPriorityCount = 3;
+
+    struct WorkNode
+    {
+        static constexpr u64 InlineEdgeCount = 4;
+
+        TaskFunction func;
+        TaskFunction callback;
+        IThreadPool* pool = nullptr;
+        WorkPriority priority = WorkPriority::Interactive;
+        u64 enqueueTicks = 0; // steady clock ns, set when the node becomes runnable
+        u64 frame = 0; // profiler frame of the submitting thread
+
+        std::atomic<u32> refs{0};
+        std::atomic<i32> pending{0}; // unfinished predecessors (+1 while being submitted)
+        std::atomic<u32> status{static_cast<u32>(WorkStatus::Pending)};
+        std::atomic<WorkEdge*> successors{nullptr};
+
+        WorkEdge edges[InlineEdgeCount];
+        std::unique_ptr<WorkEdge[]> overflowEdges; // lent by the WorkNodePool, see ReserveEdges
+        u64 overflowCapacity = 0;
+
+        WorkEdge* EdgeAt(u64 index, u64 count);
+
+        // false if this node already completed, the edge is then not linked
+        bool AddSuccessor(WorkEdge* edge);
+
+        // marks the node done and returns the detached successor list
+        WorkEdge* Complete();
+
+        void Reset();
+
+        static inline WorkEdge* const Closed = reinterpret_cast<WorkEdge*>(1);
+    };
+
+    // Slab allocator for WorkNodes, nodes are recycled and never returned to the heap while the pool lives.
+    // Workers keep a private cache and only touch the shared list in batches, other threads always use the shared list.
+    class AJ_API WorkNodePool
+    {
+    public:
+        static constexpr u64 SlabSize = 256;
+        static constexpr u64 BatchSize = 32;
+
+        struct Cache
+        {
+            Cache()
+            {
+                nodes.reserve(2 * BatchSize + 1);
+            }
+
+            std::vector<WorkNode*> nodes;
+        };
+
+        explicit WorkNodePool(IThreadPool* owner);
+
+        WorkNodePool(const WorkNodePool&) = delete;
+        WorkNodePool& operator=(const WorkNodePool&) = delete;
+
+        // cache may be null
+        WorkNode* Acquire(Cache* cache);
+
+        void Release(Cache* cache, WorkNode* node);
+
+        // gives a join wider than InlineEdgeCount its edge array, recycled ones first. which node becomes the join
+        // changes all the time, keeping the arrays here makes wide joins allocation free once warmed up
+        void ReserveEdges(WorkNode* node, u64 count);
+
+        [[nodiscard]] u64 Capacity();
+
+    private:
+        IThreadPool* owner;
+        std::mutex mutex;
+        std::vector<WorkNode*> free;
+        std::vector<std::unique_ptr<WorkNode[]>> slabs;
+        std::vector<std::pair<std::unique_ptr<WorkEdge[]>, u64>> spareEdges; // array, capacity
+
+        void Grow();
+    };
+
+    // Awaitable handle to submitted work, cheap to copy (intrusive ref count).
+    // Wait() from a pool worker keeps executing other work instead of blocking the worker.
+    class AJ_API WorkHandle
+    {
+    public:
+        WorkHandle() = default;
+
+        explicit WorkHandle(WorkNode* node);
+
+        WorkHandle(const WorkHandle& other);
+
+        WorkHandle(WorkHandle&& other) noexcept;
+
+        WorkHandle& operator=(const WorkHandle& other);
+
+        WorkHandle& operator=(WorkHandle&& other) noexcept;
+
+        ~WorkHandle();
+
+        [[nodiscard]] AJ_INLINE bool IsValid() const
+        {
+            return node != nullptr;
+        }
+
+        // invalid handles count as done
+        [[nodiscard]] bool IsDone() const;
+
+        void Wait() const;
+
+        void Reset();
+
+        [[nodiscard]] AJ_INLINE WorkNode* Node() const
+        {
+            return node;
+        }
+
+    private:
+        WorkNode* node = nullptr;
+    };
+} // Ajiva
+// Core
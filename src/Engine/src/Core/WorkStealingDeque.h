@@ -0,0 +1,105 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#pragma once
+
+#include "defines.h"
+#include "Core/Logger.h"
+
+#include <atomic>
+#include <vector>
+
+namespace Ajiva::Core
+{
+    // Bounded Chase-Lev deque (Le et al. 2013, "Correct and Efficient Work-Stealing for Weak Memory Models").
+    // Push/Pop may only be called by the owning thread, Steal from any thread.
+    template <typename T>
+    class WorkStealingDeque
+    {
+    public:
+        explicit WorkStealingDeque(u64 capacity) : mask(capacity - 1), buffer(capacity)
+        {
+            if (capacity == 0 || (capacity & (capacity - 1)) != 0)
+            {
+                AJ_FAIL("WorkStealingDeque capacity must be a power of two!");
+            }
+        }
+
+        WorkStealingDeque(const WorkStealingDeque&) = delete;
+        WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+        // returns false if the deque is full
+        bool Push(T* item)
+        {
+            i64 b = bottom.load(std::memory_order_relaxed);
+            i64 t = top.load(std::memory_order_acquire);
+            if (b - t > static_cast<i64>(mask))
+                return false;
+            buffer[b & mask].store(item, std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_release);
+            return true;
+        }
+
+        T* Pop()
+        {
+            i64 b = bottom.load(std::memory_order_relaxed) - 1;
+            bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            i64 t = top.load(std::memory_order_relaxed);
+            if (t > b)
+            {
+                // empty
+                bottom.store(b + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            T* item = buffer[b & mask].load(std::memory_order_relaxed);
+            if (t == b)
+            {
+                // last item, race against thieves
+                if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    item = nullptr;
+                bottom.store(b + 1, std::memory_order_relaxed);
+            }
+            return item;
+        }
+
+        T* Steal()
+        {
+            i64 t = top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            i64 b = bottom.load(std::memory_order_acquire);
+            if (t >= b)
+                return nullptr;
+            T* item = buffer[t & mask].load(std::memory_order_relaxed);
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return nullptr; // lost the race, caller may retry elsewhere
+            return item;
+        }
+
+        // approximate, only exact when called by the owner without concurrent thieves
+        [[nodiscard]] AJ_INLINE u64 Size() const
+        {
+            i64 b = bottom.load(std::memory_order_relaxed);
+            i64 t = top.load(std::memory_order_relaxed);
+            return b > t ? static_cast<u64>(b - t) : 0;
+        }
+
+        [[nodiscard]] AJ_INLINE bool IsEmpty() const
+        {
+            return Size() == 0;
+        }
+
+        [[nodiscard]] AJ_INLINE u64 Capacity() const
+        {
+            return mask + 1;
+        }
+
+    private:
+        alignas(64) std::atomic<i64> top{0};
+        alignas(64) std::atomic<i64> bottom{0};
+        alignas(64) u64 mask;
+        std::vector<std::atomic<T*>> buffer;
+    };
+} // Ajiva
+// Core
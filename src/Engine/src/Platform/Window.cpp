@@ -46,23 +46,24 @@ namespace Ajiva::Platform
         glfwSetWindowPos(window, config.X, config.Y);
         glfwSetWindowUserPointer(window, this);
 
+        // callbacks run on the window thread when it is dedicated, events are only posted and then dispatched by
+        // the main thread at the start of the next frame
 #define GLFW_USER_PTR_CHECK() \
             auto *windowClass = reinterpret_cast<Window *>(glfwGetWindowUserPointer(pWindow)); \
             if (!windowClass) \
                 return;   \
-            auto ev = windowClass->eventSystem;
+            auto& ev = windowClass->eventSystem;
 
         glfwSetFramebufferSizeCallback(window, [](GLFWwindow* pWindow, int width, int height)
         {
             GLFW_USER_PTR_CHECK()
             windowClass->config.Width = static_cast<u32>(width);
             windowClass->config.Height = static_cast<u32>(height);
-            if (ev->FireEvent(Core::EventCode::FramebufferResize, windowClass, {
-                                  .framebufferSize = {
-                                      .width = windowClass->config.Width, .height = windowClass->config.Height
-                                  }
-                              }))
-                return;
+            ev->PostEvent(Core::EventCode::FramebufferResize, windowClass, {
+                              .framebufferSize = {
+                                  .width = windowClass->config.Width, .height = windowClass->config.Height
+                              }
+                          });
         });
         glfwSetKeyCallback(window, [](GLFWwindow* pWindow, int key, int scancode, int action, int mods)
         {
@@ -73,9 +74,8 @@ namespace Ajiva::Platform
             else if (action == GLFW_RELEASE)
                 eventCore = Core::EventCode::KeyUp;
             else return;
-            if (ev->FireEvent(eventCore, windowClass,
-                              {.key = {.key = key, .scancode = scancode, .action = action, .mods = mods}}))
-                return;
+            ev->PostEvent(eventCore, windowClass,
+                          {.key = {.key = key, .scancode = scancode, .action = action, .mods = mods}});
         });
         glfwSetMouseButtonCallback(window, [](GLFWwindow* pWindow, int button, int action, int mods)
         {
@@ -88,16 +88,15 @@ namespace Ajiva::Platform
             else return;
             f64 x, y;
             glfwGetCursorPos(pWindow, &x, &y);
-            if (ev->FireEvent(eventCore, windowClass,
-                              {
-                                  .mouse = {
-                                      .click = {
-                                          .x = static_cast<i32>(x), .y = static_cast<i32>(y), .button = button,
-                                          .mods = mods
-                                      }
+            ev->PostEvent(eventCore, windowClass,
+                          {
+                              .mouse = {
+                                  .click = {
+                                      .x = static_cast<i32>(x), .y = static_cast<i32>(y), .button = button,
+                                      .mods = mods
                                   }
-                              }))
-                return;
+                              }
+                          });
         });
         glfwSetCursorPosCallback(window, [](GLFWwindow* pWindow, f64 x, f64 y)
         {
@@ -114,21 +113,19 @@ namespace Ajiva::Platform
             };
             windowClass->prevMousePos.x = context.mouse.move.x;
             windowClass->prevMousePos.y = context.mouse.move.y;
-            if (ev->FireEvent(Core::EventCode::MouseMove, windowClass, context))
-                return;
+            ev->PostEvent(Core::EventCode::MouseMove, windowClass, context);
         });
         glfwSetScrollCallback(window, [](GLFWwindow* pWindow, f64 xOffset, f64 yOffset)
         {
             GLFW_USER_PTR_CHECK()
-            if (ev->FireEvent(Core::EventCode::MouseScroll, windowClass, {
-                                  .mouse = {
-                                      .wheel = {
-                                          .xOffset = xOffset,
-                                          .yOffset = yOffset
-                                      }
+            ev->PostEvent(Core::EventCode::MouseScroll, windowClass, {
+                              .mouse = {
+                                  .wheel = {
+                                      .xOffset = xOffset,
+                                      .yOffset = yOffset
                                   }
-                              }))
-                return;
+                              }
+                          });
         });
 #undef GLFW_USER_PTR_CHECK
 
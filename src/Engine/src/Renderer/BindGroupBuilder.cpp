@@ -3,6 +3,9 @@
 //
 
 #include "BindGroupBuilder.h"
+#include "Core/FlightRecorder.h"
+#include "Core/Logger.h"
+#include "Core/Profiler.h"
 
 
 namespace Ajiva::Renderer
@@ -70,7 +73,7 @@ namespace Ajiva::Renderer
             PLOG_WARNING << "BindGroup already build for: " << this;
         }
 
-        PLOG_INFO << "Build BindGroupLayout for: " << this;
+        AJ_LOG(Renderer, debug) << "Build BindGroupLayout for: " << this;
         for (int i = 0; i < bindings.size(); ++i)
         {
             auto& entry = bindings[i];
@@ -79,13 +82,13 @@ namespace Ajiva::Renderer
                 PLOG_ERROR << "Binding: " << i << " is not equal to " << entry.binding;
             }
             if (entry.buffer)
-                PLOG_INFO << "\tBinding: " << i << " is Buffer " << entry.buffer;
+                AJ_LOG(Renderer, verbose) << "\tBinding: " << i << " is Buffer " << entry.buffer;
             else if (entry.sampler)
-                PLOG_INFO << "\tBinding: " << i << " is Sampler " << entry.sampler;
+                AJ_LOG(Renderer, verbose) << "\tBinding: " << i << " is Sampler " << entry.sampler;
             else if (entry.textureView)
-                PLOG_INFO << "\tBinding: " << i << " is TextureView " << entry.textureView;
+                AJ_LOG(Renderer, verbose) << "\tBinding: " << i << " is TextureView " << entry.textureView;
             else
-                PLOG_INFO << "\tBinding: " << i << " is Empty";
+                AJ_LOG(Renderer, verbose) << "\tBinding: " << i << " is Empty";
         }
 
         bindGroupLayout = context->CreateBindGroupLayout(bindingLayoutEntries);
@@ -99,6 +102,7 @@ namespace Ajiva::Renderer
 
     void BindGroupBuilder::UpdateBindings()
     {
+        AJ_PROFILE_SCOPE("BindGroupBuilder::UpdateBindings");
         bool needsUpdate = false;
 
         int j = 0;
@@ -113,6 +117,8 @@ namespace Ajiva::Renderer
                     PLOG_DEBUG << "Binding Texture " << j << " updated from " << textureVersions[j] << " to "
                                << texture->GetVersion() << " view from " << binding.textureView << " to "
                                << texture->view;
+                    AJ_FLIGHT_DEBUG("binding {} texture version {} -> {}", j, textureVersions[j],
+                                    texture->GetVersion());
                     binding.textureView = texture->view;
                     textureVersions[j] = texture->GetVersion();
                 }
@@ -121,6 +127,9 @@ namespace Ajiva::Renderer
         }
 
         if (needsUpdate)
+        {
+            AJ_FLIGHT_DEBUG("rebuild bind group {} with {} bindings", this, bindings.size());
             bindGroup = context->CreateBindGroup(bindGroupLayout, bindings);
+        }
     }
 } // Ajiva
@@ -4,6 +4,8 @@
 
 #include "Buffer.h"
 #include "Resource/ResourceManager.h"
+#include "Renderer/GpuContext.h"
+#include "Core/Logger.h"
 
 #include <utility>
 
@@ -15,14 +17,14 @@ namespace Ajiva::Renderer
         if (cleanUp)
         {
             buffer.destroy();
-            AJ_RegisterDestroyed(this, typeid(Buffer));
         }
+        AJ_RegisterDestroyed(this, typeid(Buffer));
     }
 
     Buffer::Buffer(wgpu::Buffer buffer, u64 size, u64 alignedSize, Ref<wgpu::Queue> queue, bool cleanUp) :
         buffer(buffer), m_queue(std::move(queue)), cleanUp(cleanUp), size(size), alignedSize(alignedSize)
     {
-        AJ_RegisterCreated(this, typeid(Buffer));
+        AJ_RegisterCreated(this, typeid(Buffer), alignedSize);
     }
 
     void Buffer::UpdateBufferData(const void* data, uint64_t updateSize, uint64_t offset)
@@ -31,8 +33,8 @@ namespace Ajiva::Renderer
             updateSize = this->size;
         if (offset + updateSize > this->size)
         {
-            PLOG_WARNING << "Buffer::UpdateBufferData: updateSize + offset > this->size: " << updateSize << " + "
-                         << offset << " > " << this->size;
+            AJ_LOG_EVERY_MS(Renderer, warning, 1000) << "Buffer::UpdateBufferData: updateSize + offset > this->size: "
+                << updateSize << " + " << offset << " > " << this->size;
             updateSize = this->size - offset;
         }
         m_queue->writeBuffer(buffer, offset, data, ALIGN_AT(updateSize, 4));
@@ -54,4 +56,25 @@ namespace Ajiva::Renderer
             std::memcpy(data, from, copySize);
         });
     }
+
+    Core::Task<bool> Buffer::ReadAsync(const GpuContext& context, void* data, uint64_t copySize, uint64_t offset)
+    {
+        if (copySize == INVALID_ID_U64)
+            copySize = this->size;
+        if (offset + copySize > this->size)
+        {
+            PLOG_WARNING << "Buffer::ReadAsync: copySize + offset > this->size: " << copySize << " + "
+                         << offset << " > " << this->size;
+            copySize = this->size - offset;
+        }
+        auto status = co_await context.MapBuffer(buffer, wgpu::MapMode::Read, offset, copySize);
+        if (status != wgpu::BufferMapAsyncStatus::Success)
+        {
+            PLOG_WARNING << "Buffer::ReadAsync: map failed: " << static_cast<int>(status);
+            co_return false;
+        }
+        std::memcpy(data, buffer.getConstMappedRange(offset, copySize), copySize);
+        buffer.unmap();
+        co_return true;
+    }
 } // Ajiva::Renderer
@@ -7,6 +7,8 @@
 #include "defines.h"
 #include "webgpu/webgpu.hpp"
 #include "Core/Logger.h"
+#include "Core/Task.h"
+#include "Renderer/GpuMemory.h"
 
 namespace Ajiva::Renderer
 {
@@ -161,6 +163,8 @@ namespace Ajiva::Renderer
         u64 size;
         u64 alignedSize;
         wgpu::Buffer buffer;
+        // given back with the buffer, set by GpuContext::CreateBuffer
+        GpuMemoryAllocation memory;
 
         Buffer(wgpu::Buffer buffer, u64 size, u64 alignedSize, Ref<wgpu::Queue> queue, bool cleanUp = true);
 
@@ -169,6 +173,11 @@ namespace Ajiva::Renderer
         void UpdateBufferData(void const* data, uint64_t updateSize = INVALID_ID_U64, uint64_t offset = 0);
 
         Scope<wgpu::BufferMapCallback> CopyTo(void* data, uint64_t copySize = INVALID_ID_U64, uint64_t offset = 0);
+
+        // maps for reading, copies into data and unmaps again. needs MapRead usage, context, buffer and data have
+        // to outlive the task. resumes on the main thread inside GpuContext::PollEvents, false if mapping failed
+        Core::Task<bool> ReadAsync(const GpuContext& context, void* data, uint64_t copySize = INVALID_ID_U64,
+                                   uint64_t offset = 0);
     };
 } // Ajiva
 
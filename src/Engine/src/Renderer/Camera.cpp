@@ -91,12 +91,15 @@ namespace Ajiva::Renderer
 
     void FreeCamera::translate(glm::vec3 v)
     {
+        // a jump, not a movement
+        previousPosition += v;
         position += v;
         viewMatrix = glm::lookAt(position, position + front, up);
     }
 
     void FreeCamera::Update()
     {
+        previousPosition = position;
         acceleration *= 0.9f;
         if (forward_down)
             acceleration += front * speed;
@@ -116,6 +119,17 @@ namespace Ajiva::Renderer
         viewMatrix = glm::lookAt(position, position + front, up);
     }
 
+    glm::vec3 FreeCamera::RenderPosition(f64 alpha) const
+    {
+        return glm::mix(previousPosition, position, static_cast<float>(alpha));
+    }
+
+    glm::mat4 FreeCamera::RenderViewMatrix(f64 alpha) const
+    {
+        const glm::vec3 eye = RenderPosition(alpha);
+        return glm::lookAt(eye, eye + front, up);
+    }
+
     void FreeCamera::onMouseMove(AJ_EVENT_PARAMETERS)
     {
         if (active)
@@ -177,6 +191,7 @@ namespace Ajiva::Renderer
     void FreeCamera::Init()
     {
         EventCamera::Init();
+        previousPosition = position;
         onMouseMoved(0, 0);
     }
 }
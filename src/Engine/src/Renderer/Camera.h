@@ -40,6 +40,17 @@ namespace Ajiva::Renderer
 
         virtual void Update() = 0;
 
+        // where the renderer sees the camera, alpha (0..1) between the previous and the current fixed update
+        [[nodiscard]] virtual glm::vec3 RenderPosition([[maybe_unused]] f64 alpha) const
+        {
+            return position;
+        }
+
+        [[nodiscard]] virtual glm::mat4 RenderViewMatrix([[maybe_unused]] f64 alpha) const
+        {
+            return viewMatrix;
+        }
+
         virtual void translate(glm::vec3 v)
         {
             position += v;
@@ -84,7 +95,7 @@ namespace Ajiva::Renderer
 
         bool init = false;
         Ref<Ajiva::Core::EventSystem> eventSystem;
-        std::vector<Ref<Core::IListener>> events;
+        std::vector<Core::EventSubscription> events;
     };
 
     class AJ_API OrbitCamera : public EventCamera
@@ -159,7 +170,13 @@ namespace Ajiva::Renderer
 
         void translate(glm::vec3 v) override;
 
+        // movement is interpolated, looking around is not, it already happens once a frame
+        [[nodiscard]] glm::vec3 RenderPosition(f64 alpha) const override;
+
+        [[nodiscard]] glm::mat4 RenderViewMatrix(f64 alpha) const override;
+
     private:
+        glm::vec3 previousPosition = {0, 0, 0};
         glm::vec2 angles = {0, 0};
         glm::vec3 front = glm::vec3(1.0f, 0.0f, 0.0f);
         glm::vec3 up = glm::vec3(0.0f, 0.0f, 1.0f);
@@ -186,6 +203,6 @@ namespace Ajiva::Renderer
         bool up_down = false;
         bool down_down = false;
         Ref<Ajiva::Core::EventSystem> eventSystem;
-        std::vector<Ref<Core::IListener>> events;
+        std::vector<Core::EventSubscription> events;
     };
 }
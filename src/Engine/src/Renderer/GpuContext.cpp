@@ -6,11 +6,13 @@
 
 #include "magic_enum.hpp"
 #include "Core/Logger.h"
+#include "Core/FlightRecorder.h"
 
 namespace Ajiva::Renderer
 {
     bool GpuContext::Init(const std::function<wgpu::Surface(wgpu::Instance)>& createSurface)
     {
+        completions = CreateRef<Core::MainThreadDispatcher>();
         instance = CreateScope<wgpu::Instance>(createInstance(wgpu::InstanceDescriptor{}));
         if (!instance)
         {
@@ -48,9 +50,17 @@ namespace Ajiva::Renderer
         //DON'T CARE JUST GIVE ALL
         requiredLimits.limits = supportedLimits.limits;
 
+        // optional, only the gpu profiler uses it
+        const bool timestampQueries = adapter->hasFeature(wgpu::FeatureName::TimestampQuery);
+        std::vector<WGPUFeatureName> requiredFeatures;
+        if (timestampQueries)
+            requiredFeatures.push_back(WGPUFeatureName_TimestampQuery);
+
         wgpu::DeviceDescriptor deviceDesc;
         deviceDesc.label = "My Device"; // anything works here, that's your call
         deviceDesc.requiredLimits = &requiredLimits;
+        deviceDesc.requiredFeatureCount = requiredFeatures.size();
+        deviceDesc.requiredFeatures = requiredFeatures.data();
         deviceDesc.defaultQueue.label = "The default queue";
         device = CreateScope<wgpu::Device>(adapter->requestDevice(deviceDesc));
         PLOG_INFO << "Got device: " << device.get();
@@ -83,27 +93,30 @@ namespace Ajiva::Renderer
             swapChainFormat = wgpu::TextureFormat::BGRA8Unorm;
         PLOG_INFO << "SwapChainFormat: " << magic_enum::enum_name<WGPUTextureFormat>(swapChainFormat).data();
 
+        gpuProfiler = CreateRef<GpuProfiler>(*this, timestampQueries);
         return true;
     }
 
     GpuContext::~GpuContext()
     {
+        gpuProfiler.reset();
         queue.reset();
         device.reset();
         adapter.reset();
         instance.reset();
     }
 
-    Ref<wgpu::SwapChain> GpuContext::CreateSwapChain(int width, int height) const
+    Ref<wgpu::SwapChain> GpuContext::CreateSwapChain(int width, int height, wgpu::PresentMode presentMode) const
     {
         wgpu::SwapChainDescriptor swapChainDesc;
         swapChainDesc.width = width;
         swapChainDesc.height = height;
         swapChainDesc.format = swapChainFormat;
-        swapChainDesc.presentMode = wgpu::PresentMode::Fifo;
+        swapChainDesc.presentMode = presentMode;
         swapChainDesc.usage = wgpu::TextureUsage::RenderAttachment;
 
         wgpu::SwapChain swapChain = device->createSwapChain(*surface, swapChainDesc);
+        AJ_FLIGHT_DEBUG("swap chain {}x{} present mode {}", width, height, static_cast<WGPUPresentMode>(presentMode));
         PLOG_INFO << "Created swap chain: " << &swapChain;
         return CreateScope<wgpu::SwapChain>(swapChain);
     }
@@ -117,9 +130,11 @@ namespace Ajiva::Renderer
 
     wgpu::RenderPassEncoder
     GpuContext::CreateRenderPassEncoder(wgpu::CommandEncoder& encoder, wgpu::TextureView& textureView,
-                                        wgpu::TextureView depthTextureView, wgpu::Color clearColor)
+                                        wgpu::TextureView depthTextureView, wgpu::Color clearColor,
+                                        char const* label)
     {
         wgpu::RenderPassDescriptor renderPassDesc{};
+        renderPassDesc.label = label;
         wgpu::RenderPassColorAttachment renderPassColorAttachment;
         renderPassColorAttachment.view = textureView;
         renderPassColorAttachment.resolveTarget = nullptr;
@@ -155,10 +170,62 @@ namespace Ajiva::Renderer
 
         renderPassDesc.depthStencilAttachment = &depthStencilAttachment;
 
-        renderPassDesc.timestampWrites = nullptr;
+        renderPassDesc.timestampWrites = gpuProfiler->RenderPass(label);
+        AJ_FLIGHT_DEBUG("render pass {} timed {}", label, renderPassDesc.timestampWrites != nullptr);
         return encoder.beginRenderPass(renderPassDesc);
     }
 
+    void GpuContext::PollEvents() const
+    {
+#ifdef WEBGPU_BACKEND_WGPU
+        // an empty submit makes wgpu-native process finished work and fire its callbacks
+        queue->submit(0, nullptr);
+#else
+        instance->processEvents();
+#endif
+        completions->DrainAll();
+    }
+
+    QueueWorkDoneAwaiter GpuContext::QueueWorkDone() const
+    {
+        return {this};
+    }
+
+    BufferMapAwaiter GpuContext::MapBuffer(wgpu::Buffer buffer, WGPUMapModeFlags mode, u64 offset, u64 size) const
+    {
+        return {this, buffer, mode, offset, size};
+    }
+
+    void QueueWorkDoneAwaiter::await_suspend(std::coroutine_handle<> handle)
+    {
+        // register from the main thread only, otherwise the callback could resume us before it is stored
+        if (!context->completions->IsMainThread())
+        {
+            context->completions->Post([this, handle]() { await_suspend(handle); });
+            return;
+        }
+        callback = context->queue->onSubmittedWorkDone([this, handle](wgpu::QueueWorkDoneStatus result)
+        {
+            status = result;
+            // resumed after the backend returned, the callback object is destroyed together with this awaiter
+            context->completions->Post(Core::ResumeCoroutine{handle});
+        });
+    }
+
+    void BufferMapAwaiter::await_suspend(std::coroutine_handle<> handle)
+    {
+        if (!context->completions->IsMainThread())
+        {
+            context->completions->Post([this, handle]() { await_suspend(handle); });
+            return;
+        }
+        callback = buffer.mapAsync(mode, offset, size, [this, handle](wgpu::BufferMapAsyncStatus result)
+        {
+            status = result;
+            context->completions->Post(Core::ResumeCoroutine{handle});
+        });
+    }
+
     void GpuContext::SubmitCommandBuffer(wgpu::CommandBuffer& commandBuffer) const
     {
         queue->submit(1, &commandBuffer);
@@ -351,9 +418,15 @@ namespace Ajiva::Renderer
                                         : wgpu::TextureViewDimension::_2D; // todo check for array?
         textureViewDesc.format = textureFormat;
         wgpu::TextureView textureView = texture.createView(textureViewDesc);
+        AJ_FLIGHT_DEBUG("texture {} {}x{}x{} format {} mips {}", label, textureSize.width, textureSize.height,
+                        textureSize.depthOrArrayLayers, textureFormat, mipLevelCount);
         PLOG_INFO << "Texture(" << textureFormat << "): " << texture;
-        return CreateRef<Ajiva::Renderer::Texture>(texture, textureView, queue, textureFormat, textureAspect,
-                                                   textureSize);
+        auto result = CreateRef<Ajiva::Renderer::Texture>(texture, textureView, queue, textureFormat, textureAspect,
+                                                          textureSize);
+        result->memory = gpuMemory->Allocate(GpuMemory::TextureCategory(usage),
+                                             GpuMemory::TextureBytes(textureFormat, textureSize, mipLevelCount,
+                                                                     textureSize.depthOrArrayLayers > 1));
+        return result;
     }
 
     Ref<Ajiva::Renderer::Texture> GpuContext::CreateDepthTexture(const WGPUExtent3D& textureSize)
@@ -377,6 +450,7 @@ namespace Ajiva::Renderer
     GpuContext::CreateBindGroup(const Ref<wgpu::BindGroupLayout>& bindGroupLayout,
                                 std::vector<wgpu::BindGroupEntry> bindings) const
     {
+        AJ_FLIGHT_DEBUG("bind group with {} entries", bindings.size());
         PLOG_INFO << "Creating bind group";
         // A bind group contains one or multiple bindings
         wgpu::BindGroupDescriptor bindGroupDesc;
@@ -390,8 +464,10 @@ namespace Ajiva::Renderer
     }
 
     Ref<Ajiva::Renderer::Buffer>
-    GpuContext::CreateBuffer(uint64_t size, WGPUBufferUsageFlags usage, const char* label) const
+    GpuContext::CreateBuffer(uint64_t size, WGPUBufferUsageFlags usage, const char* label,
+                             std::optional<GpuMemoryCategory> category) const
     {
+        AJ_FLIGHT_DEBUG("buffer {} size {} usage {}", label, size, usage);
         PLOG_VERBOSE << "Creating buffer: " << label << " size: " << size;
         wgpu::BufferDescriptor bufferDesc;
         bufferDesc.label = label;
@@ -399,14 +475,16 @@ namespace Ajiva::Renderer
         bufferDesc.size = ALIGN_AT(size, 4);
         bufferDesc.mappedAtCreation = false;
         auto buffer = device->createBuffer(bufferDesc);
-        return CreateRef<Ajiva::Renderer::Buffer>(buffer, size, bufferDesc.size, queue);
+        auto result = CreateRef<Ajiva::Renderer::Buffer>(buffer, size, bufferDesc.size, queue);
+        result->memory = gpuMemory->Allocate(category.value_or(GpuMemory::BufferCategory(usage)), bufferDesc.size);
+        return result;
     }
 
     Ref<Ajiva::Renderer::Buffer>
     GpuContext::CreateFilledBuffer(const void* data, uint64_t size, WGPUBufferUsageFlags usage,
-                                   const char* label) const
+                                   const char* label, std::optional<GpuMemoryCategory> category) const
     {
-        auto buffer = CreateBuffer(size, usage, label);
+        auto buffer = CreateBuffer(size, usage, label, category);
         buffer->UpdateBufferData(data, size);
         return buffer;
     }
@@ -12,13 +12,73 @@
 #include "Renderer/Texture.h"
 #include "glm/glm.hpp"
 #include "Structures.h"
+#include "Core/MainThreadDispatcher.h"
+#include "Renderer/GpuProfiler.h"
+#include "Renderer/GpuMemory.h"
+
+#include <coroutine>
+#include <optional>
 
 namespace Ajiva::Renderer
 {
+    class GpuContext;
+
+    // co_await context.QueueWorkDone(): resumes once everything submitted so far finished on the GPU.
+    // Callbacks only fire inside PollEvents, the coroutine resumes there on the main thread.
+    struct AJ_API QueueWorkDoneAwaiter
+    {
+        const GpuContext* context;
+        wgpu::QueueWorkDoneStatus status = wgpu::QueueWorkDoneStatus::Unknown;
+        Scope<wgpu::QueueWorkDoneCallback> callback;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle);
+
+        wgpu::QueueWorkDoneStatus await_resume() const noexcept
+        {
+            return status;
+        }
+    };
+
+    // co_await context.MapBuffer(...): resumes once the range is mapped (or failed), same threading as above
+    struct AJ_API BufferMapAwaiter
+    {
+        const GpuContext* context;
+        wgpu::Buffer buffer;
+        WGPUMapModeFlags mode;
+        u64 offset;
+        u64 size;
+        wgpu::BufferMapAsyncStatus status = wgpu::BufferMapAsyncStatus::Unknown;
+        Scope<wgpu::BufferMapCallback> callback;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle);
+
+        wgpu::BufferMapAsyncStatus await_resume() const noexcept
+        {
+            return status;
+        }
+    };
+
     class GpuContext
     {
         Ref<wgpu::ErrorCallback> callback;
         Ref<wgpu::Surface> surface = nullptr;
+        // coroutines waiting on GPU callbacks, drained by PollEvents (shared by copies of the context)
+        Ref<Core::MainThreadDispatcher> completions;
+        Ref<GpuProfiler> gpuProfiler = CreateRef<GpuProfiler>();
+        Ref<GpuMemory> gpuMemory = CreateRef<GpuMemory>();
+
+        friend struct QueueWorkDoneAwaiter;
+        friend struct BufferMapAwaiter;
 
     public:
         Ref<wgpu::Instance> instance;
@@ -35,13 +95,14 @@ namespace Ajiva::Renderer
         bool Init(const std::function<wgpu::Surface(wgpu::Instance)>& createSurface);
 
         [[nodiscard]] Ref<wgpu::SwapChain>
-        CreateSwapChain(int width, int height) const;
+        CreateSwapChain(int width, int height, wgpu::PresentMode presentMode = wgpu::PresentMode::Fifo) const;
 
         [[nodiscard]] wgpu::CommandEncoder CreateCommandEncoder(char const* label = "Command Encoder") const;
 
         [[nodiscard]] wgpu::RenderPassEncoder
         CreateRenderPassEncoder(wgpu::CommandEncoder& encoder, wgpu::TextureView& textureView,
-                                wgpu::TextureView depthTextureView, wgpu::Color clearColor = {0.1, 0.1, 0.1, 1.0});
+                                wgpu::TextureView depthTextureView, wgpu::Color clearColor = {0.1, 0.1, 0.1, 1.0},
+                                char const* label = "Render Pass");
 
         void SubmitCommandBuffer(wgpu::CommandBuffer& commandBuffer) const;
 
@@ -49,6 +110,26 @@ namespace Ajiva::Renderer
 
         void SubmitEncoder(wgpu::CommandEncoder& encoder, char const* label = "Command buffer") const;
 
+        // lets the backend fire its callbacks, then resumes every coroutine they completed. main thread, once a frame
+        void PollEvents() const;
+
+        // disabled unless the adapter supports timestamp queries
+        [[nodiscard]] GpuProfiler& GetGpuProfiler() const
+        {
+            return *gpuProfiler;
+        }
+
+        // every buffer and texture created through this context, shared by its copies
+        [[nodiscard]] GpuMemory& GetGpuMemory() const
+        {
+            return *gpuMemory;
+        }
+
+        [[nodiscard]] QueueWorkDoneAwaiter QueueWorkDone() const;
+
+        [[nodiscard]] BufferMapAwaiter
+        MapBuffer(wgpu::Buffer buffer, WGPUMapModeFlags mode, u64 offset, u64 size) const;
+
 
         [[nodiscard]] Ref<wgpu::ShaderModule>
         CreateShaderModuleFromCode(const std::string& code) const;
@@ -81,13 +162,16 @@ namespace Ajiva::Renderer
         CreateBindGroup(const Ref<wgpu::BindGroupLayout>& bindGroupLayout,
                         std::vector<wgpu::BindGroupEntry> bindings) const;
 
+        // the memory category follows from the usage unless given
         [[nodiscard]] Ref<Ajiva::Renderer::Buffer>
         CreateBuffer(uint64_t size, WGPUBufferUsageFlags usage =
-                         wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::CopySrc, char const* label = "Buffer") const;
+                         wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::CopySrc, char const* label = "Buffer",
+                     std::optional<GpuMemoryCategory> category = std::nullopt) const;
 
         [[nodiscard]] Ref<Ajiva::Renderer::Buffer>
         CreateFilledBuffer(void const* data, uint64_t size,
                            WGPUBufferUsageFlags usage = wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::CopySrc,
-                           char const* label = "Buffer") const;
+                           char const* label = "Buffer",
+                           std::optional<GpuMemoryCategory> category = std::nullopt) const;
     };
 }
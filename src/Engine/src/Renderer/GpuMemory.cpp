@@ -0,0 +1,195 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#include "GpuMemory.h"
+#include "Core/Logger.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace Ajiva::Renderer
+{
+    const char* GpuMemoryCategoryName(GpuMemoryCategory category)
+    {
+        static const char* Names[] = {
+            "Vertex", "Index", "Instance", "Uniform", "Storage", "Texture", "Render Target", "Staging", "Other"
+        };
+        return category < GpuMemoryCategory::Count ? Names[static_cast<u8>(category)] : "Total";
+    }
+
+    GpuMemoryAllocation::GpuMemoryAllocation(Ref<GpuMemory> owner, GpuMemoryCategory category, u64 bytes)
+        : owner(std::move(owner)), category(category), bytes(bytes)
+    {
+    }
+
+    GpuMemoryAllocation::~GpuMemoryAllocation()
+    {
+        Release();
+    }
+
+    GpuMemoryAllocation::GpuMemoryAllocation(GpuMemoryAllocation&& other) noexcept
+        : owner(std::move(other.owner)), category(other.category), bytes(std::exchange(other.bytes, 0))
+    {
+    }
+
+    GpuMemoryAllocation& GpuMemoryAllocation::operator=(GpuMemoryAllocation&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Release();
+            owner = std::move(other.owner);
+            category = other.category;
+            bytes = std::exchange(other.bytes, 0);
+        }
+        return *this;
+    }
+
+    void GpuMemoryAllocation::Release()
+    {
+        if (owner) owner->Release(category, bytes);
+        owner.reset();
+        bytes = 0;
+    }
+
+    GpuMemoryAllocation GpuMemory::Allocate(GpuMemoryCategory category, u64 bytes)
+    {
+        auto& counter = counters[static_cast<u8>(category)];
+        const u64 used = counter.bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        counter.count.fetch_add(1, std::memory_order_relaxed);
+        u64 peak = counter.peak.load(std::memory_order_relaxed);
+        while (used > peak && !counter.peak.compare_exchange_weak(peak, used, std::memory_order_relaxed))
+        {
+        }
+        const u64 total = totalBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        version.fetch_add(1, std::memory_order_relaxed);
+
+        // only the allocation that crosses a budget reports it
+        const u64 budget = counter.budget.load(std::memory_order_relaxed);
+        if (budget && used > budget && used - bytes <= budget)
+            OverBudget(category, used, budget);
+        const u64 limit = totalBudget.load(std::memory_order_relaxed);
+        if (limit && total > limit && total - bytes <= limit)
+            OverBudget(GpuMemoryCategory::Count, total, limit);
+
+        return {shared_from_this(), category, bytes};
+    }
+
+    void GpuMemory::Release(GpuMemoryCategory category, u64 bytes)
+    {
+        auto& counter = counters[static_cast<u8>(category)];
+        counter.bytes.fetch_sub(bytes, std::memory_order_relaxed);
+        counter.count.fetch_sub(1, std::memory_order_relaxed);
+        totalBytes.fetch_sub(bytes, std::memory_order_relaxed);
+        version.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    GpuMemoryUsage GpuMemory::Usage(GpuMemoryCategory category) const
+    {
+        const auto& counter = counters[static_cast<u8>(category)];
+        return {
+            counter.bytes.load(std::memory_order_relaxed), counter.count.load(std::memory_order_relaxed),
+            counter.peak.load(std::memory_order_relaxed)
+        };
+    }
+
+    void GpuMemory::SetBudget(const GpuMemoryBudget& budget)
+    {
+        for (u64 i = 0; i < CategoryCount; ++i)
+            counters[i].budget.store(budget.Categories[i], std::memory_order_relaxed);
+        totalBudget.store(budget.Total, std::memory_order_relaxed);
+    }
+
+    GpuMemoryBudget GpuMemory::GetBudget() const
+    {
+        GpuMemoryBudget budget;
+        for (u64 i = 0; i < CategoryCount; ++i)
+            budget.Categories[i] = counters[i].budget.load(std::memory_order_relaxed);
+        budget.Total = totalBudget.load(std::memory_order_relaxed);
+        return budget;
+    }
+
+    void GpuMemory::SetOverBudgetCallback(OverBudgetCallback callback)
+    {
+        std::lock_guard<std::mutex> lock(callbackMutex);
+        overBudget = std::move(callback);
+    }
+
+    void GpuMemory::OverBudget(GpuMemoryCategory category, u64 used, u64 budget)
+    {
+        std::lock_guard<std::mutex> lock(callbackMutex);
+        if (overBudget)
+        {
+            overBudget(category, used, budget);
+            return;
+        }
+        PLOG_WARNING << "GpuMemory: " << GpuMemoryCategoryName(category) << " over budget, " << used << " of "
+            << budget << " bytes";
+    }
+
+    u64 GpuMemory::TexelBytes(WGPUTextureFormat format)
+    {
+        switch (format)
+        {
+        case WGPUTextureFormat_R8Unorm:
+        case WGPUTextureFormat_R8Snorm:
+        case WGPUTextureFormat_R8Uint:
+        case WGPUTextureFormat_R8Sint:
+        case WGPUTextureFormat_Stencil8:
+            return 1;
+        case WGPUTextureFormat_R16Uint:
+        case WGPUTextureFormat_R16Sint:
+        case WGPUTextureFormat_R16Float:
+        case WGPUTextureFormat_RG8Unorm:
+        case WGPUTextureFormat_RG8Snorm:
+        case WGPUTextureFormat_RG8Uint:
+        case WGPUTextureFormat_RG8Sint:
+        case WGPUTextureFormat_Depth16Unorm:
+            return 2;
+        case WGPUTextureFormat_RG32Float:
+        case WGPUTextureFormat_RG32Uint:
+        case WGPUTextureFormat_RG32Sint:
+        case WGPUTextureFormat_RGBA16Uint:
+        case WGPUTextureFormat_RGBA16Sint:
+        case WGPUTextureFormat_RGBA16Float:
+        case WGPUTextureFormat_Depth32FloatStencil8:
+            return 8;
+        case WGPUTextureFormat_RGBA32Float:
+        case WGPUTextureFormat_RGBA32Uint:
+        case WGPUTextureFormat_RGBA32Sint:
+            return 16;
+        default:
+            // rgba8, bgra8, r32, rg16, packed and depth24/32 formats
+            return 4;
+        }
+    }
+
+    u64 GpuMemory::TextureBytes(WGPUTextureFormat format, const WGPUExtent3D& size, u32 mipLevelCount, bool is3D)
+    {
+        const u64 texel = TexelBytes(format);
+        u64 bytes = 0;
+        for (u32 level = 0; level < std::max(mipLevelCount, 1u); ++level)
+        {
+            const u64 width = std::max(size.width >> level, 1u);
+            const u64 height = std::max(size.height >> level, 1u);
+            const u64 depth = is3D ? std::max(size.depthOrArrayLayers >> level, 1u) : size.depthOrArrayLayers;
+            bytes += width * height * depth * texel;
+        }
+        return bytes;
+    }
+
+    GpuMemoryCategory GpuMemory::BufferCategory(WGPUBufferUsageFlags usage)
+    {
+        if (usage & WGPUBufferUsage_Index) return GpuMemoryCategory::Index;
+        if (usage & WGPUBufferUsage_Vertex) return GpuMemoryCategory::Vertex;
+        if (usage & WGPUBufferUsage_Uniform) return GpuMemoryCategory::Uniform;
+        if (usage & WGPUBufferUsage_Storage) return GpuMemoryCategory::Storage;
+        if (usage & (WGPUBufferUsage_MapRead | WGPUBufferUsage_MapWrite)) return GpuMemoryCategory::Staging;
+        return GpuMemoryCategory::Other;
+    }
+
+    GpuMemoryCategory GpuMemory::TextureCategory(WGPUTextureUsageFlags usage)
+    {
+        return usage & WGPUTextureUsage_RenderAttachment ? GpuMemoryCategory::RenderTarget : GpuMemoryCategory::Texture;
+    }
+}
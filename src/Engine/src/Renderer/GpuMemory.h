@@ -0,0 +1,148 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#pragma once
+
+#include "defines.h"
+#include "webgpu/webgpu.hpp"
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+
+namespace Ajiva::Renderer
+{
+    enum class GpuMemoryCategory : u8
+    {
+        Vertex,
+        Index,
+        Instance,
+        Uniform,
+        Storage,
+        Texture,
+        RenderTarget,
+        Staging, // mappable buffers
+        Other,
+        Count,
+    };
+
+    AJ_API const char* GpuMemoryCategoryName(GpuMemoryCategory category);
+
+    // bytes, 0 is unlimited
+    struct GpuMemoryBudget
+    {
+        u64 Categories[static_cast<u8>(GpuMemoryCategory::Count)] = {};
+        u64 Total = 0;
+    };
+
+    struct GpuMemoryUsage
+    {
+        u64 Bytes = 0;
+        u64 Count = 0;
+        u64 PeakBytes = 0;
+    };
+
+    class GpuMemory;
+
+    // what one buffer or texture holds, given back when it is destroyed. move only
+    class AJ_API GpuMemoryAllocation
+    {
+    public:
+        GpuMemoryAllocation() = default;
+
+        GpuMemoryAllocation(Ref<GpuMemory> owner, GpuMemoryCategory category, u64 bytes);
+
+        ~GpuMemoryAllocation();
+
+        GpuMemoryAllocation(GpuMemoryAllocation&& other) noexcept;
+        GpuMemoryAllocation& operator=(GpuMemoryAllocation&& other) noexcept;
+
+        GpuMemoryAllocation(const GpuMemoryAllocation&) = delete;
+        GpuMemoryAllocation& operator=(const GpuMemoryAllocation&) = delete;
+
+        void Release();
+
+        [[nodiscard]] GpuMemoryCategory Category() const
+        {
+            return category;
+        }
+
+        [[nodiscard]] u64 Bytes() const
+        {
+            return bytes;
+        }
+
+    private:
+        Ref<GpuMemory> owner;
+        GpuMemoryCategory category = GpuMemoryCategory::Other;
+        u64 bytes = 0;
+    };
+
+    // Running GPU memory totals per category, kept up to date by GpuContext::CreateBuffer/CreateTexture and the
+    // destructors of what they return. Every counter is an atomic, reading them is O(1) from any thread. Crossing a
+    // budget calls the over budget callback once, on the thread that allocated.
+    class AJ_API GpuMemory : public std::enable_shared_from_this<GpuMemory>
+    {
+    public:
+        static constexpr u64 CategoryCount = static_cast<u8>(GpuMemoryCategory::Count);
+
+        // category is Count when the total budget was crossed
+        using OverBudgetCallback = std::function<void(GpuMemoryCategory category, u64 usedBytes, u64 budgetBytes)>;
+
+        [[nodiscard]] GpuMemoryAllocation Allocate(GpuMemoryCategory category, u64 bytes);
+
+        [[nodiscard]] GpuMemoryUsage Usage(GpuMemoryCategory category) const;
+
+        [[nodiscard]] u64 TotalBytes() const
+        {
+            return totalBytes.load(std::memory_order_relaxed);
+        }
+
+        // changes with every allocation and release, cheap to poll for "did anything change"
+        [[nodiscard]] u64 Version() const
+        {
+            return version.load(std::memory_order_relaxed);
+        }
+
+        void SetBudget(const GpuMemoryBudget& budget);
+
+        [[nodiscard]] GpuMemoryBudget GetBudget() const;
+
+        // without one, crossing a budget logs a warning
+        void SetOverBudgetCallback(OverBudgetCallback callback);
+
+        // the whole mip chain, 3D textures halve their depth per level, array layers do not
+        [[nodiscard]] static u64 TextureBytes(WGPUTextureFormat format, const WGPUExtent3D& size, u32 mipLevelCount,
+                                              bool is3D);
+
+        // unknown and block compressed formats count as 4
+        [[nodiscard]] static u64 TexelBytes(WGPUTextureFormat format);
+
+        [[nodiscard]] static GpuMemoryCategory BufferCategory(WGPUBufferUsageFlags usage);
+
+        [[nodiscard]] static GpuMemoryCategory TextureCategory(WGPUTextureUsageFlags usage);
+
+    private:
+        friend class GpuMemoryAllocation;
+
+        struct alignas(64) Counter
+        {
+            std::atomic<u64> bytes{0};
+            std::atomic<u64> count{0};
+            std::atomic<u64> peak{0};
+            std::atomic<u64> budget{0};
+        };
+
+        Counter counters[CategoryCount];
+        std::atomic<u64> totalBytes{0};
+        std::atomic<u64> totalBudget{0};
+        std::atomic<u64> version{0};
+        std::mutex callbackMutex;
+        OverBudgetCallback overBudget;
+
+        void Release(GpuMemoryCategory category, u64 bytes);
+
+        void OverBudget(GpuMemoryCategory category, u64 used, u64 budget);
+    };
+}
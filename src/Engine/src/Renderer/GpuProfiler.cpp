@@ -0,0 +1,136 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#include "GpuProfiler.h"
+#include "Renderer/GpuContext.h"
+
+namespace Ajiva::Renderer
+{
+    static constexpr u64 SlotBytes = GpuProfiler::MaxPasses * 2 * sizeof(u64);
+    static_assert(SlotBytes % 256 == 0, "resolveQuerySet offsets have to be 256 byte aligned");
+
+    GpuProfiler::GpuProfiler(const GpuContext& context, bool supported)
+        : device(context.device), queue(context.queue), supported(supported), enabled(supported)
+    {
+        if (!supported)
+        {
+            PLOG_INFO << "GpuProfiler: adapter has no timestamp queries, GPU timing is disabled";
+            return;
+        }
+
+        wgpu::QuerySetDescriptor querySetDesc = wgpu::Default;
+        querySetDesc.label = "GpuProfiler Queries";
+        querySetDesc.type = wgpu::QueryType::Timestamp;
+        querySetDesc.count = MaxPasses * 2 * FramesInFlight;
+        querySet = device->createQuerySet(querySetDesc);
+
+        resolve = context.CreateBuffer(SlotBytes * FramesInFlight,
+                                       wgpu::BufferUsage::QueryResolve | wgpu::BufferUsage::CopySrc,
+                                       "GpuProfiler Resolve");
+        for (u32 i = 0; i < FramesInFlight; ++i)
+        {
+            auto& slot = slots[i];
+            slot.readback = context.CreateBuffer(SlotBytes, wgpu::BufferUsage::MapRead | wgpu::BufferUsage::CopyDst,
+                                                 "GpuProfiler Readback");
+            for (u32 pass = 0; pass < MaxPasses; ++pass)
+            {
+                const u32 begin = (i * MaxPasses + pass) * 2;
+                slot.render[pass] = {querySet, begin, begin + 1};
+                slot.compute[pass] = {querySet, begin, begin + 1};
+            }
+        }
+    }
+
+    GpuProfiler::~GpuProfiler()
+    {
+        // unmapping aborts a pending map and fires its callback right away, before the callbacks go
+        for (auto& slot : slots)
+        {
+            if (slot.state == SlotState::Pending) slot.readback->buffer.unmap();
+        }
+        if (querySet)
+        {
+            querySet.destroy();
+            querySet.release();
+        }
+    }
+
+    const WGPURenderPassTimestampWrites* GpuProfiler::RenderPass(const char* name)
+    {
+        u32 index;
+        if (!Allocate(name, index)) return nullptr;
+        return &slots[frame % FramesInFlight].render[index];
+    }
+
+    const WGPUComputePassTimestampWrites* GpuProfiler::ComputePass(const char* name)
+    {
+        u32 index;
+        if (!Allocate(name, index)) return nullptr;
+        return &slots[frame % FramesInFlight].compute[index];
+    }
+
+    bool GpuProfiler::Allocate(const char* name, u32& index)
+    {
+        if (!enabled) return false;
+        auto& slot = slots[frame % FramesInFlight];
+        if (slot.state != SlotState::Free || slot.count >= MaxPasses) return false;
+        index = slot.count++;
+        slot.names[index] = name;
+        return true;
+    }
+
+    void GpuProfiler::EndFrame()
+    {
+        auto& slot = slots[frame % FramesInFlight];
+        const u64 recorded = frame++;
+        if (slot.state != SlotState::Free) return;
+        if (!enabled || slot.count == 0)
+        {
+            slot.count = 0;
+            return;
+        }
+
+        const u64 index = &slot - slots;
+        const u64 bytes = slot.count * 2 * sizeof(u64);
+        wgpu::CommandEncoderDescriptor encoderDesc;
+        encoderDesc.label = "GpuProfiler Resolve";
+        auto encoder = device->createCommandEncoder(encoderDesc);
+        encoder.resolveQuerySet(querySet, index * MaxPasses * 2, slot.count * 2, resolve->buffer, index * SlotBytes);
+        encoder.copyBufferToBuffer(resolve->buffer, index * SlotBytes, slot.readback->buffer, 0, bytes);
+        wgpu::CommandBufferDescriptor commandBufferDesc;
+        commandBufferDesc.label = "GpuProfiler Resolve";
+        auto commands = encoder.finish(commandBufferDesc);
+        queue->submit(1, &commands);
+
+        slot.state = SlotState::Pending;
+        slot.frame = recorded;
+        // fires inside PollEvents on the main thread
+        slot.callback = slot.readback->buffer.mapAsync(wgpu::MapMode::Read, 0, bytes,
+                                                       [this, &slot](wgpu::BufferMapAsyncStatus status)
+                                                       {
+                                                           Read(slot, status);
+                                                       });
+    }
+
+    void GpuProfiler::Read(Slot& slot, wgpu::BufferMapAsyncStatus status)
+    {
+        if (status == wgpu::BufferMapAsyncStatus::Success)
+        {
+            const u64 bytes = slot.count * 2 * sizeof(u64);
+            auto ticks = static_cast<const u64*>(slot.readback->buffer.getConstMappedRange(0, bytes));
+            timings.clear();
+            for (u32 i = 0; i < slot.count; ++i)
+            {
+                // timestamps are nanoseconds, a pass the GPU did not run reads as zero
+                const u64 begin = ticks[i * 2];
+                const u64 end = ticks[i * 2 + 1];
+                timings.push_back({slot.names[i], end > begin ? static_cast<f64>(end - begin) / 1e6 : 0.0});
+            }
+            slot.readback->buffer.unmap();
+            latency = frame - slot.frame;
+        }
+        slot.count = 0;
+        slot.state = SlotState::Free;
+    }
+}
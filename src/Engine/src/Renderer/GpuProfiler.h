@@ -0,0 +1,107 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+#pragma once
+
+#include "defines.h"
+#include "webgpu/webgpu.hpp"
+#include "Renderer/Buffer.h"
+
+#include <vector>
+
+namespace Ajiva::Renderer
+{
+    class GpuContext;
+
+    struct GpuPassTiming
+    {
+        const char* Name;
+        f64 Ms;
+    };
+
+    // Per pass GPU time through timestamp queries. Passes ask for their timestamp writes while recording, EndFrame
+    // resolves the frame's queries and maps a readback buffer. The results arrive in GpuContext::PollEvents a few
+    // frames later, nothing ever waits on the GPU. A frame whose readback slot is still mapped is not measured.
+    // Without the TimestampQuery feature every call is a no-op and the passes get nullptr.
+    class AJ_API GpuProfiler
+    {
+    public:
+        static constexpr u32 MaxPasses = 16; // per frame, 2 queries each: one resolve slot is 256 bytes
+        static constexpr u32 FramesInFlight = 3;
+
+        GpuProfiler() = default;
+
+        GpuProfiler(const GpuContext& context, bool supported);
+
+        ~GpuProfiler();
+
+        GpuProfiler(const GpuProfiler&) = delete;
+        GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+        [[nodiscard]] bool IsEnabled() const
+        {
+            return enabled;
+        }
+
+        void SetEnabled(bool enable)
+        {
+            enabled = enable && supported;
+        }
+
+        // for RenderPassDescriptor::timestampWrites, nullptr when not measured. name has to be a literal
+        [[nodiscard]] const WGPURenderPassTimestampWrites* RenderPass(const char* name);
+
+        [[nodiscard]] const WGPUComputePassTimestampWrites* ComputePass(const char* name);
+
+        // after the last pass of the frame was submitted
+        void EndFrame();
+
+        // newest complete frame, in pass order
+        [[nodiscard]] const std::vector<GpuPassTiming>& Timings() const
+        {
+            return timings;
+        }
+
+        // frames between recording and the timings showing up
+        [[nodiscard]] u64 Latency() const
+        {
+            return latency;
+        }
+
+    private:
+        enum class SlotState : u8
+        {
+            Free,
+            Pending, // resolved, waiting for the map callback
+        };
+
+        struct Slot
+        {
+            SlotState state = SlotState::Free;
+            u32 count = 0;
+            u64 frame = 0;
+            const char* names[MaxPasses] = {};
+            WGPURenderPassTimestampWrites render[MaxPasses] = {};
+            WGPUComputePassTimestampWrites compute[MaxPasses] = {};
+            Ref<Buffer> readback;
+            Scope<wgpu::BufferMapCallback> callback;
+        };
+
+        Ref<wgpu::Device> device;
+        Ref<wgpu::Queue> queue;
+        wgpu::QuerySet querySet = nullptr;
+        Ref<Buffer> resolve;
+        Slot slots[FramesInFlight];
+        bool supported = false;
+        bool enabled = false;
+        u64 frame = 0;
+        u64 latency = 0;
+        std::vector<GpuPassTiming> timings;
+
+        // next query pair of this frame, false if the frame is not measured
+        bool Allocate(const char* name, u32& index);
+
+        void Read(Slot& slot, wgpu::BufferMapAsyncStatus status);
+    };
+}
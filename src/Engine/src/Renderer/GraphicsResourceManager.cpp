@@ -24,22 +24,21 @@ namespace Ajiva::Renderer
 
     std::string GraphicsResourceManager::Statistics()
     {
+        // O(categories), the context keeps the totals current
+        const auto& memory = context->GetGpuMemory();
         std::stringstream ss;
         ss << "GraphicsResourceManager: " << std::endl;
         ss << "  Textures: " << textures.size() << std::endl;
-        u64 size = 0;
-        for (auto& texture : textures)
-        {
-            size += texture.second->size.width * texture.second->size.height * 4;
-        }
-        ss << "  Textures Size: " << size << std::endl;
         ss << "  Buffers: " << buffers.size() << std::endl;
-        size = 0;
-        for (auto& buffer : buffers)
+        ss << "  GPU Memory: " << memory.TotalBytes() << std::endl;
+        for (u64 i = 0; i < GpuMemory::CategoryCount; ++i)
         {
-            size += buffer->size;
+            const auto category = static_cast<GpuMemoryCategory>(i);
+            const auto usage = memory.Usage(category);
+            if (!usage.Count && !usage.PeakBytes) continue;
+            ss << "    " << GpuMemoryCategoryName(category) << ": " << usage.Bytes << " in " << usage.Count
+                << " (peak " << usage.PeakBytes << ")" << std::endl;
         }
-        ss << "  Buffers Size: " << size << std::endl;
         return ss.str();
     }
 } // Ajiva
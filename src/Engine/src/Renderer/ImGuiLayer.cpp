@@ -4,6 +4,9 @@
 
 #include "ImGuiLayer.h"
 
+#include <algorithm>
+#include <cfloat>
+#include <cstdio>
 #include <utility>
 
 #include "imgui_impl_glfw.h"
@@ -13,9 +16,11 @@
 namespace Ajiva::Renderer
 {
     ImGuiLayer::ImGuiLayer(Ref<Platform::Window> window, Ref<GpuContext> context, Ref<Core::EventSystem> eventSystem,
-                           Ref<Renderer::RenderPipelineLayer> pipeline, Ref<Renderer::FreeCamera> camara)
+                           Ref<Renderer::RenderPipelineLayer> pipeline, Ref<Renderer::FreeCamera> camara,
+                           Ref<Core::IThreadPool> threadPool, Ref<Core::FrameStatistics> frameStatistics)
         : Layer("ImGuiLayer"), window(std::move(window)), context(std::move(context)),
-          eventSystem(std::move(eventSystem)), pipeline(std::move(pipeline)), camara(std::move(camara))
+          eventSystem(std::move(eventSystem)), pipeline(std::move(pipeline)), camara(std::move(camara)),
+          threadPool(std::move(threadPool)), frameStatistics(std::move(frameStatistics))
     {
         //catch events as soon as possible
         this->events.push_back(this->eventSystem->Add(Core::MouseButtonDown, this, &ImGuiLayer::OnMouse));
@@ -83,6 +88,12 @@ namespace Ajiva::Renderer
 
         if (show_overlay)
             ShowOverlay();
+
+        if (show_thread_pool_window)
+            ShowThreadPoolWindow();
+
+        if (show_profiler_window)
+            ShowProfilerWindow();
     }
 
     void ImGuiLayer::ShowOverlay()  {
@@ -117,6 +128,61 @@ namespace Ajiva::Renderer
             else
                 ImGui::Text("Mouse Position: <invalid>");
             ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / io.Framerate, io.Framerate);
+            if (frameStatistics) {
+                // the average hides stutter, the tail shows it
+                const auto& summary = frameStatistics->Summary();
+                const auto& frameTimes = frameStatistics->Window();
+                ImGui::Text("p50 %.2f  p90 %.2f  p99 %.2f  max %.2f ms", summary.P50Ms, summary.P90Ms,
+                            summary.P99Ms, summary.MaxMs);
+                ImGui::Text("Hitches > %.1f ms: %llu in %llu frames, %llu total",
+                            frameStatistics->GetConfig().HitchMs, summary.Hitches, summary.Frames,
+                            frameStatistics->SessionHitches());
+                ImGui::PlotLines("##frametimes", frameTimes.data(), static_cast<int>(frameTimes.size()),
+                                 static_cast<int>(frameStatistics->WindowOffset()), nullptr, 0.0f,
+                                 static_cast<float>(summary.MaxMs), ImVec2(300, 40));
+                if (ImGui::SmallButton("Dump frame times")) {
+                    frameStatistics->WriteCsv("frame_times.csv");
+                    frameStatistics->WriteHistogramCsv("frame_times_histogram.csv");
+                }
+            }
+            if (threadPool) {
+                SampleThreadPool();
+                f64 utilization = 0;
+                for (u64 i = 0; i < poolStats.WorkerBusyMs.size(); ++i)
+                    utilization += poolStats.Utilization(previousPoolStats, i);
+                if (!poolStats.WorkerBusyMs.empty())
+                    utilization /= static_cast<f64>(poolStats.WorkerBusyMs.size());
+                ImGui::Separator();
+                ImGui::Text("Pool: %llu queued, %llu active, %.0f%% busy", poolStats.Queued, poolStats.Active,
+                            utilization * 100.0);
+                ImGui::Checkbox("Thread Pool Details", &show_thread_pool_window);
+            }
+            if (context) {
+                // running totals, nothing is walked here
+                const auto& memory = context->GetGpuMemory();
+                const auto budget = memory.GetBudget();
+                ImGui::Separator();
+                ImGui::Text("GPU memory: %.2f MiB", static_cast<f64>(memory.TotalBytes()) / (1024.0 * 1024.0));
+                if (budget.Total)
+                    ImGui::ProgressBar(static_cast<float>(memory.TotalBytes()) / static_cast<float>(budget.Total),
+                                       ImVec2(300, 0));
+                if (ImGui::TreeNode("By category")) {
+                    for (u64 i = 0; i < GpuMemory::CategoryCount; ++i) {
+                        const auto category = static_cast<GpuMemoryCategory>(i);
+                        const auto usage = memory.Usage(category);
+                        if (!usage.Count && !usage.PeakBytes) continue;
+                        ImGui::Text("%-13s %8.2f MiB in %llu, peak %.2f MiB", GpuMemoryCategoryName(category),
+                                    static_cast<f64>(usage.Bytes) / (1024.0 * 1024.0), usage.Count,
+                                    static_cast<f64>(usage.PeakBytes) / (1024.0 * 1024.0));
+                        if (budget.Categories[i]) {
+                            ImGui::SameLine();
+                            ImGui::Text("/ %.2f MiB", static_cast<f64>(budget.Categories[i]) / (1024.0 * 1024.0));
+                        }
+                    }
+                    ImGui::TreePop();
+                }
+            }
+            ImGui::Checkbox("Profiler", &show_profiler_window);
             if (ImGui::BeginPopupContextWindow()) {
                 if (ImGui::MenuItem("Custom", NULL, location == -1)) location = -1;
                 if (ImGui::MenuItem("Center", NULL, location == -2)) location = -2;
@@ -131,6 +197,160 @@ namespace Ajiva::Renderer
         ImGui::End();
     }
 
+    void ImGuiLayer::SampleThreadPool() {
+        // a short window makes utilization jumpy, a long one hides spikes
+        const f64 now = ImGui::GetTime();
+        if (now - poolStatsSampledAt < 0.5) return;
+        poolStatsSampledAt = now;
+        previousPoolStats = std::move(poolStats);
+        poolStats = threadPool->GetStats();
+    }
+
+    void ImGuiLayer::ShowThreadPoolWindow() {
+        if (!threadPool) return;
+        if (!ImGui::Begin("Thread Pool", &show_thread_pool_window)) {
+            ImGui::End();
+            return;
+        }
+        SampleThreadPool();
+        ImGui::Text("Queued: %llu (high water %llu), active: %llu", poolStats.Queued, poolStats.QueuedHighWater,
+                    poolStats.Active);
+        ImGui::Text("Blocked producers: %llu, %.3f ms total", poolStats.BlockedProducerCount,
+                    poolStats.BlockedProducerMs);
+
+        ImGui::SeparatorText("Latency (ms)");
+        if (ImGui::BeginTable("latency", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+            ImGui::TableSetupColumn("");
+            ImGui::TableSetupColumn("Count");
+            ImGui::TableSetupColumn("Avg");
+            ImGui::TableSetupColumn("P50");
+            ImGui::TableSetupColumn("P99");
+            ImGui::TableSetupColumn("Max");
+            ImGui::TableHeadersRow();
+            auto row = [](const char* name, const Core::HistogramSnapshot& histogram) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(name);
+                ImGui::TableNextColumn();
+                ImGui::Text("%llu", histogram.Count);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", histogram.AverageMs());
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", histogram.PercentileMs(0.5));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", histogram.PercentileMs(0.99));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", histogram.MaxMs());
+            };
+            row("Wait: frame", poolStats.QueueLatency[static_cast<u64>(Core::WorkPriority::FrameCritical)]);
+            row("Wait: interactive", poolStats.QueueLatency[static_cast<u64>(Core::WorkPriority::Interactive)]);
+            row("Wait: background", poolStats.QueueLatency[static_cast<u64>(Core::WorkPriority::Background)]);
+            row("Execution", poolStats.Execution);
+            ImGui::EndTable();
+        }
+
+        ImGui::SeparatorText("Workers");
+        for (u64 i = 0; i < poolStats.WorkerBusyMs.size(); ++i) {
+            auto utilization = static_cast<float>(poolStats.Utilization(previousPoolStats, i));
+            char label[32];
+            snprintf(label, sizeof(label), "%llu: %.0f%%", i, utilization * 100.0f);
+            ImGui::ProgressBar(utilization, ImVec2(-1, 0), label);
+        }
+
+        ImGui::SeparatorText("Execution histogram");
+        float buckets[Core::HistogramSnapshot::BucketCount];
+        for (u64 i = 0; i < Core::HistogramSnapshot::BucketCount; ++i)
+            buckets[i] = static_cast<float>(poolStats.Execution.Buckets[i]);
+        ImGui::PlotHistogram("##execution", buckets, Core::HistogramSnapshot::BucketCount, 0,
+                             "log2 ns buckets", 0, FLT_MAX, ImVec2(-1, 80));
+        ImGui::End();
+    }
+
+    void ImGuiLayer::ShowProfilerWindow() {
+        if (!ImGui::Begin("Profiler", &show_profiler_window)) {
+            ImGui::End();
+            return;
+        }
+#if AJ_PROFILING
+        auto& profiler = Core::Profiler::Get();
+        ImGui::SetNextItemWidth(120);
+        ImGui::InputInt("frames", &profilerCaptureFrames);
+        ImGui::SameLine();
+        ImGui::BeginDisabled(profiler.IsCapturing());
+        if (ImGui::Button("Capture trace"))
+            profiler.CaptureFrames(static_cast<u32>(std::max(profilerCaptureFrames, 1)), "profile.json");
+        ImGui::EndDisabled();
+        ImGui::SameLine();
+        ImGui::Text("dropped: %llu", profiler.DroppedCount());
+
+        // two frames back, pool tasks of the newest frames may still be running
+        const u64 frame = profiler.Frame() > 2 ? profiler.Frame() - 2 : 0;
+        const auto events = profiler.FrameEvents(frame);
+        const auto threads = profiler.ThreadNames();
+        if (events.empty()) {
+            ImGui::TextUnformatted("no scopes recorded");
+        } else {
+            u64 begin = events.front().StartNs, end = events.front().EndNs;
+            for (const auto& event : events) {
+                begin = std::min(begin, event.StartNs);
+                end = std::max(end, event.EndNs);
+            }
+            ImGui::Text("frame %llu: %.3f ms", frame, static_cast<f64>(end - begin) / 1e6);
+
+            // one lane per thread, nested scopes stack downwards
+            const float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+            const float labelWidth = 140.0f;
+            const ImVec2 origin = ImGui::GetCursorScreenPos();
+            const float width = std::max(ImGui::GetContentRegionAvail().x - labelWidth, 50.0f);
+            const f64 scale = width / static_cast<f64>(std::max<u64>(end - begin, 1));
+            auto drawList = ImGui::GetWindowDrawList();
+            u32 lane = 0;
+            float y = origin.y;
+            for (u64 i = 0; i < events.size(); ++i) {
+                const auto& event = events[i];
+                if (i == 0 || event.Thread != events[i - 1].Thread) {
+                    if (i) y += rowHeight * static_cast<float>(lane + 1);
+                    lane = 0;
+                    drawList->AddText(ImVec2(origin.x, y), ImGui::GetColorU32(ImGuiCol_Text),
+                                      event.Thread < threads.size() ? threads[event.Thread].c_str() : "?");
+                }
+                lane = std::max(lane, event.Depth);
+                const ImVec2 min(origin.x + labelWidth + static_cast<float>((event.StartNs - begin) * scale),
+                                 y + rowHeight * static_cast<float>(event.Depth));
+                const float right = origin.x + labelWidth + static_cast<float>((event.EndNs - begin) * scale);
+                const ImVec2 max(std::max(min.x + 1.0f, right), min.y + rowHeight - 1.0f);
+                const auto hue = static_cast<float>(reinterpret_cast<uintptr_t>(event.Name) % 97) / 97.0f;
+                drawList->AddRectFilled(min, max, ImColor::HSV(hue, 0.5f, 0.7f));
+                drawList->PushClipRect(min, max, true);
+                drawList->AddText(ImVec2(min.x + 2.0f, min.y), IM_COL32_WHITE, event.Name);
+                drawList->PopClipRect();
+                if (ImGui::IsMouseHoveringRect(min, max))
+                    ImGui::SetTooltip("%s\n%.3f ms", event.Name, static_cast<f64>(event.EndNs - event.StartNs) / 1e6);
+            }
+            y += rowHeight * static_cast<float>(lane + 1);
+            ImGui::Dummy(ImVec2(labelWidth + width, y - origin.y));
+        }
+#else
+        ImGui::TextUnformatted("built without AJ_PROFILING");
+#endif
+        ShowGpuTimings();
+        ImGui::End();
+    }
+
+    void ImGuiLayer::ShowGpuTimings() {
+        auto& gpuProfiler = context->GetGpuProfiler();
+        if (!gpuProfiler.IsEnabled()) {
+            ImGui::TextUnformatted("GPU: no timestamp queries");
+            return;
+        }
+        f64 total = 0;
+        for (const auto& timing : gpuProfiler.Timings())
+            total += timing.Ms;
+        ImGui::Text("GPU: %.3f ms (%llu frames late)", total, gpuProfiler.Latency());
+        for (const auto& timing : gpuProfiler.Timings())
+            ImGui::BulletText("%s: %.3f ms", timing.Name, timing.Ms);
+    }
+
     void ImGuiLayer::AfterRender(Core::UpdateInfo frameInfo, Core::RenderTarget target)
     {
         Layer::AfterRender(frameInfo, target);
@@ -239,7 +459,8 @@ namespace Ajiva::Renderer
         renderPassDesc.colorAttachmentCount = 1;
         renderPassDesc.colorAttachments = &renderPassColorAttachment;
 
-        renderPassDesc.timestampWrites = nullptr;
+        renderPassDesc.label = "ImGui Pass";
+        renderPassDesc.timestampWrites = context->GetGpuProfiler().RenderPass("ImGui Pass");
         auto renderPass = encoder.beginRenderPass(renderPassDesc);
         ImGui_ImplWGPU_RenderDrawData(ImGui::GetDrawData(), renderPass);
         renderPass.end();
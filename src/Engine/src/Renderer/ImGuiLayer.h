@@ -12,6 +12,9 @@
 #include "RenderPipelineLayer.h"
 #include "Platform/Window.h"
 #include "Camera.h"
+#include "Core/ThreadPool.h"
+#include "Core/Profiler.h"
+#include "Core/FrameStatistics.h"
 
 namespace Ajiva::Renderer
 {
@@ -19,7 +22,15 @@ namespace Ajiva::Renderer
     {
     public:
         ImGuiLayer(Ref<Platform::Window> window, Ref<GpuContext> context, Ref<Core::EventSystem> eventSystem,
-                   Ref<Renderer::RenderPipelineLayer> pipeline, Ref<Renderer::FreeCamera> camara);
+                   Ref<Renderer::RenderPipelineLayer> pipeline, Ref<Renderer::FreeCamera> camara,
+                   Ref<Core::IThreadPool> threadPool = nullptr,
+                   Ref<Core::FrameStatistics> frameStatistics = nullptr);
+
+        // the event subscriptions point at this
+        ImGuiLayer(const ImGuiLayer&) = delete;
+        ImGuiLayer& operator=(const ImGuiLayer&) = delete;
+        ImGuiLayer(ImGuiLayer&&) = delete;
+        ImGuiLayer& operator=(ImGuiLayer&&) = delete;
 
         bool Attached() override;
 
@@ -36,18 +47,28 @@ namespace Ajiva::Renderer
         Ref<Ajiva::Renderer::GpuContext> context;
         Ref<Ajiva::Core::EventSystem> eventSystem;
 
-        std::vector<Ref<Ajiva::Core::IListener>> events;
+        std::vector<Ajiva::Core::EventSubscription> events;
 
         bool OnMouse(AJ_EVENT_PARAMETERS);
         bool OnKey(AJ_EVENT_PARAMETERS);
 
         Ref<Renderer::FreeCamera> camara;
         Ref<Renderer::RenderPipelineLayer> pipeline;
+        Ref<Core::IThreadPool> threadPool;
+        Ref<Core::FrameStatistics> frameStatistics;
         bool show_demo_window = true;
         bool show_lightning_window = true;
         bool show_camera_window = true;
         bool app_log_open = true;
         bool show_overlay = true;
+        bool show_thread_pool_window = false;
+        bool show_profiler_window = false;
+        int profilerCaptureFrames = 120;
+
+        // utilization is measured between two samples
+        Core::ThreadPoolStats poolStats;
+        Core::ThreadPoolStats previousPoolStats;
+        f64 poolStatsSampledAt = 0;
 
         void ShowLightningWindow();
         void ShowCameraWindow();
@@ -55,5 +76,10 @@ namespace Ajiva::Renderer
         void RenderIntern(Core::RenderTarget target);
 
         void ShowOverlay();
+
+        void SampleThreadPool();
+        void ShowThreadPoolWindow();
+        void ShowProfilerWindow();
+        void ShowGpuTimings();
     };
 }
@@ -92,7 +92,8 @@ namespace Ajiva::Renderer
                 instanceModelData->instanceBuffer = context->CreateFilledBuffer(instanceModelData->instanceData.data(),
                     size,
                     wgpu::BufferUsage::CopyDst |
-                    wgpu::BufferUsage::Vertex); //todo check if usage is correct
+                    wgpu::BufferUsage::Vertex, "Instance Buffer",
+                    GpuMemoryCategory::Instance); //todo check if usage is correct
             }
             else
             {
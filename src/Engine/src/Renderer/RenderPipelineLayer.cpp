@@ -7,6 +7,7 @@
 #include "Resource/FilesNames.hpp"
 #include "glm/ext.hpp"
 #include "imgui.h"
+#include "Core/Parallel.h"
 #include <random>
 
 namespace Ajiva::Renderer
@@ -167,7 +168,8 @@ namespace Ajiva::Renderer
         wgpu::CommandEncoder encoder = context->CreateCommandEncoder();
         wgpu::RenderPassEncoder renderPass = context->CreateRenderPassEncoder(encoder, target.texture,
                                                                               depthTexture->view,
-                                                                              {0.4, 0.4, 0.4, 1.0});
+                                                                              {0.4, 0.4, 0.4, 1.0},
+                                                                              "RenderPipeline Pass");
         renderPass.setPipeline(*renderPipeline);
         renderPass.setBindGroup(0, *bindGroupBuilder.bindGroup, 0, nullptr); //todo move to mesh/Instance??
 
@@ -192,61 +194,75 @@ namespace Ajiva::Renderer
         ImGui::Text("Triangles: %s", get_formatted_size_1000(
                 modelInstances.size() * modelInstances.data()->operator->()->model->model->vertexData.size() / 3));
 
-        std::random_device rd;
-        std::mt19937 gen(rd());
+        // every chunk gets its own generator seeded from the chunk start
+        constexpr u64 grain = 4096;
+        auto pool = loader->GetThreadPool();
+        const u32 seed = std::random_device{}();
+        auto forEachInstance = [&](auto&& apply)
+        {
+            Core::ParallelFor(pool, 0, modelInstances.size(), grain, [&](u64 begin, u64 end)
+            {
+                std::mt19937 gen(seed + static_cast<u32>(begin));
+                auto local = apply; // distributions carry state, one copy per chunk
+                for (u64 i = begin; i < end; ++i)
+                {
+                    local(modelInstances[i]->data(), gen);
+                }
+            });
+        };
         std::uniform_real_distribution<float> pos(0.0f, 100.0f);
         std::uniform_real_distribution<float> color(0.0f, 1.0f);
 
         if (ImGui::Button("Randomize Positions"))
         {
-            for (auto& modelInstance : modelInstances)
+            forEachInstance([pos](InstanceData& data, std::mt19937& gen) mutable
             {
-                modelInstance->data().modelMatrix = translate(
+                data.modelMatrix = translate(
                     mat4(1.0f),
                     vec3(pos(gen), pos(gen), pos(gen)));
-            }
+            });
         }
         ImGui::SameLine();
         if (ImGui::Button("Random Rotation"))
         {
-            for (auto& modelInstance : modelInstances)
+            forEachInstance([pos](InstanceData& data, std::mt19937& gen) mutable
             {
-                modelInstance->data().modelMatrix = glm::rotate(
-                    modelInstance->data().modelMatrix,
+                data.modelMatrix = glm::rotate(
+                    data.modelMatrix,
                     radians(pos(gen)),
                     vec3(pos(gen), pos(gen), pos(gen)));
-            }
+            });
         }
         ImGui::SameLine();
         if (ImGui::Button("Random Scale"))
         {
-            for (auto& modelInstance : modelInstances)
+            forEachInstance([color](InstanceData& data, std::mt19937& gen) mutable
             {
                 auto scale = color(gen);
-                modelInstance->data().modelMatrix[0][0] = scale;
-                modelInstance->data().modelMatrix[1][1] = scale;
-                modelInstance->data().modelMatrix[2][2] = scale;
-            }
+                data.modelMatrix[0][0] = scale;
+                data.modelMatrix[1][1] = scale;
+                data.modelMatrix[2][2] = scale;
+            });
         }
 
         if (ImGui::Button("Randomize Colors"))
         {
-            for (auto& modelInstance : modelInstances)
+            forEachInstance([color](InstanceData& data, std::mt19937& gen) mutable
             {
-                modelInstance->data().color = vec4(color(gen), color(gen), color(gen), 1.0f);
-            }
+                data.color = vec4(color(gen), color(gen), color(gen), 1.0f);
+            });
         }
         ImGui::SameLine();
         if (ImGui::Button("Gradient Colors"))
         {
-            for (auto& modelInstance : modelInstances)
+            forEachInstance([](InstanceData& data, std::mt19937&)
             {
-                modelInstance->data().color = vec4(
-                    modelInstance->data().modelMatrix[3][0] / 100.0f,
-                    modelInstance->data().modelMatrix[3][1] / 100.0f,
-                    modelInstance->data().modelMatrix[3][2] / 100.0f,
+                data.color = vec4(
+                    data.modelMatrix[3][0] / 100.0f,
+                    data.modelMatrix[3][1] / 100.0f,
+                    data.modelMatrix[3][2] / 100.0f,
                     1.0f);
-            }
+            });
         }
 
         ImGuiListClipper clipper;
@@ -267,23 +283,28 @@ namespace Ajiva::Renderer
         ImGui::End();
     }
 
-    void Renderer::RenderPipelineLayer::Update(Core::UpdateInfo frameInfo)
+    void Renderer::RenderPipelineLayer::BeforeRender(Core::UpdateInfo frameInfo, Core::RenderTarget target)
     {
-        Layer::Update(frameInfo);
+        Layer::BeforeRender(frameInfo, target);
         instanceModelManager->Update();
+        // swapped in textures are bound in the frame they arrived in, with or without a fixed step
         bindGroupBuilder.UpdateBindings();
 
         uniforms.time = frameInfo.TotalTime;
         /*        uniforms.modelMatrix = glm::rotate(mat4x4(1.0), uniforms.time, vec3(0.0, 0.0, 1.0)) *
                                        glm::translate(mat4x4(1.0), vec3(0.5, 0.0, 0.0)) *
                                        glm::scale(mat4x4(1.0), vec3(0.8f));*/
-        uniforms.viewMatrix = viewMatrix();
+        uniforms.viewMatrix = viewMatrix(frameInfo.Alpha);
         uniforms.projectionMatrix = projectionMatrix();
-        uniforms.worldPos = worldPos();
+        uniforms.worldPos = worldPos(frameInfo.Alpha);
         uniformBuffer->UpdateBufferData(&uniforms, sizeof(Ajiva::Renderer::UniformData));
 
         lightningUniformBuffer->UpdateBufferData(&lightningUniform, sizeof(Ajiva::Renderer::LightningUniform));
+    }
 
+    void Renderer::RenderPipelineLayer::Update(Core::UpdateInfo frameInfo)
+    {
+        Layer::Update(frameInfo);
         constexpr int NumInstances = 10;
         auto plane = graphicsResourceManager->GetModel(Ajiva::Resource::Files::Objects::cube_obj);
         int a = 0;
@@ -30,8 +30,8 @@ namespace Ajiva::Renderer
 
         RenderPipelineLayer(const Ref<Renderer::GpuContext>& context, const Ref<Resource::Loader>& loader,
                             Ref<Renderer::GraphicsResourceManager> graphicsResourceManager,
-                            std::function<mat4x4()> viewMatrix, std::function<mat4x4()> projectionMatrix,
-                            std::function<vec3()> worldPos)
+                            std::function<mat4x4(f64 alpha)> viewMatrix, std::function<mat4x4()> projectionMatrix,
+                            std::function<vec3(f64 alpha)> worldPos)
             : Layer("RenderPipeline"), context(context), loader(loader),
               graphicsResourceManager(std::move(graphicsResourceManager)),
               viewMatrix(std::move(viewMatrix)), projectionMatrix(std::move(projectionMatrix)),
@@ -65,6 +65,9 @@ namespace Ajiva::Renderer
 
         void Render(Core::UpdateInfo frameInfo, Core::RenderTarget target) override;
 
+        // uniforms and bindings, once per rendered frame with the interpolated camera
+        void BeforeRender(Core::UpdateInfo frameInfo, Core::RenderTarget target) override;
+
         void Update(Core::UpdateInfo frameInfo) override;
 
         Ajiva::Renderer::LightningUniform lightningUniform = {};
@@ -75,9 +78,9 @@ namespace Ajiva::Renderer
         Ref<Renderer::GraphicsResourceManager> graphicsResourceManager;
 
         Renderer::BindGroupBuilder bindGroupBuilder;
-        std::function<mat4x4()> viewMatrix;
+        std::function<mat4x4(f64 alpha)> viewMatrix;
         std::function<mat4x4()> projectionMatrix;
-        std::function<vec3()> worldPos;
+        std::function<vec3(f64 alpha)> worldPos;
 
 
         Ref<Ajiva::Renderer::Texture> depthTexture = nullptr;
@@ -4,6 +4,7 @@
 
 #include "Texture.h"
 #include "Core/Logger.h"
+#include "Core/Parallel.h"
 #include "Resource/ResourceManager.h"
 #include <utility>
 #include <vector>
@@ -35,6 +36,7 @@ namespace Ajiva::Renderer
         view.release();
         texture.destroy();
         texture.release();
+        memory.Release();
     }
 
     void Texture::WriteTexture(const void* data, size_t length, wgpu::Extent3D writeSize, uint32_t mipLevel)
@@ -42,7 +44,7 @@ namespace Ajiva::Renderer
         using namespace wgpu;
         if (!writeSize.width || !writeSize.height || !writeSize.depthOrArrayLayers)
         {
-            PLOG_INFO << "Texture Write Size not set, using default size";
+            AJ_LOG_ONCE(Renderer, info) << "Texture Write Size not set, using default size";
             writeSize.depthOrArrayLayers = size.depthOrArrayLayers;
             writeSize.height = size.height >> mipLevel;
             writeSize.width = size.width >> mipLevel;
@@ -88,7 +90,7 @@ namespace Ajiva::Renderer
         queue->writeTexture(destination, data, length, source, writeSize);
     }
 
-    void Texture::WriteTextureMips(const void* data, size_t length, uint32_t mipLevelCount)
+    void Texture::WriteTextureMips(const void* data, size_t length, uint32_t mipLevelCount, Core::IThreadPool* pool)
     {
         using namespace wgpu;
         if (length != 4 * size.width * size.height)
@@ -110,24 +112,30 @@ namespace Ajiva::Renderer
         {
             // Pixel data for the current level
             std::vector<u8> pixels(4 * mipLevelSize.width * mipLevelSize.height);
-            // Create mip level data
-            for (uint32_t i = 0; i < mipLevelSize.width; ++i)
+            // Create mip level data, one row per item so every chunk walks both levels linearly
+            const u8* previous = previousLevelPixels.data();
+            const uint32_t previousWidth = previousMipLevelSize.width;
+            const uint32_t width = mipLevelSize.width;
+            u8* current = pixels.data();
+            Core::ParallelFor(pool, 0, mipLevelSize.height, std::max<u64>(1, 4096 / width), [=](u64 j)
             {
-                for (uint32_t j = 0; j < mipLevelSize.height; ++j)
+                const u8* row0 = &previous[4 * ((2 * j + 0) * previousWidth)];
+                const u8* row1 = &previous[4 * ((2 * j + 1) * previousWidth)];
+                u8* p = &current[4 * (j * width)];
+                for (uint32_t i = 0; i < width; ++i, p += 4)
                 {
-                    u8* p = &pixels[4 * (j * mipLevelSize.width + i)];
                     // Get the corresponding 4 pixels from the previous level
-                    u8* p00 = &previousLevelPixels[4 * ((2 * j + 0) * previousMipLevelSize.width + (2 * i + 0))];
-                    u8* p01 = &previousLevelPixels[4 * ((2 * j + 0) * previousMipLevelSize.width + (2 * i + 1))];
-                    u8* p10 = &previousLevelPixels[4 * ((2 * j + 1) * previousMipLevelSize.width + (2 * i + 0))];
-                    u8* p11 = &previousLevelPixels[4 * ((2 * j + 1) * previousMipLevelSize.width + (2 * i + 1))];
+                    const u8* p00 = &row0[4 * (2 * i + 0)];
+                    const u8* p01 = &row0[4 * (2 * i + 1)];
+                    const u8* p10 = &row1[4 * (2 * i + 0)];
+                    const u8* p11 = &row1[4 * (2 * i + 1)];
                     // Average
                     p[0] = (p00[0] + p01[0] + p10[0] + p11[0]) / 4;
                     p[1] = (p00[1] + p01[1] + p10[1] + p11[1]) / 4;
                     p[2] = (p00[2] + p01[2] + p10[2] + p11[2]) / 4;
                     p[3] = (p00[3] + p01[3] + p10[3] + p11[3]) / 4;
                 }
-            }
+            });
             // Upload the current level
             WriteTexture(pixels.data(), pixels.size(), mipLevelSize, level);
 
@@ -170,6 +178,7 @@ namespace Ajiva::Renderer
         std::swap(this->textureFormat, toSwap->textureFormat);
         std::swap(this->aspect, toSwap->aspect);
         std::swap(this->size, toSwap->size);
+        std::swap(this->memory, toSwap->memory);
         version++;
         toSwap->version++;
         toSwap = nullptr;
@@ -6,6 +6,12 @@
 
 #include "defines.h"
 #include "webgpu/webgpu.hpp"
+#include "Renderer/GpuMemory.h"
+
+namespace Ajiva::Core
+{
+    class IThreadPool;
+}
 
 namespace Ajiva
 {
@@ -20,6 +26,8 @@ namespace Ajiva
             wgpu::Texture texture;
             wgpu::TextureView view;
             wgpu::TextureAspect aspect;
+            // set by GpuContext::CreateTexture, moves along with the backing texture
+            GpuMemoryAllocation memory;
 
             Texture(wgpu::Texture texture, wgpu::TextureView textureView, Ref<wgpu::Queue> queue,
                     wgpu::TextureFormat textureFormat, wgpu::TextureAspect aspect, wgpu::Extent3D textureSize,
@@ -36,7 +44,9 @@ namespace Ajiva
             void
             WriteTexture(const void* data, size_t length, wgpu::Extent3D writeSize = {0, 0, 0}, uint32_t mipLevel = 0);
 
-            void WriteTextureMips(const void* data, size_t length, uint32_t mipLevelCount);
+            // mip rows are generated in parallel when a pool is given
+            void WriteTextureMips(const void* data, size_t length, uint32_t mipLevelCount,
+                                  Core::IThreadPool* pool = nullptr);
 
             AJ_INLINE void SetCleanUp(bool pCleanUp) { Texture::cleanUp = pCleanUp; }
 
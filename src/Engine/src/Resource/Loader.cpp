@@ -3,6 +3,8 @@
 //
 
 #include "Loader.h"
+#include "Core/FlightRecorder.h"
+#include "Core/Profiler.h"
 
 #include <fstream>
 #include <vector>
@@ -172,22 +174,41 @@ namespace Ajiva::Resource
         }
     }
 
-    Ref<Renderer::Texture>
-    Loader::LoadTexture(const std::filesystem::path& resourcePath, const Renderer::GpuContext& context,
-                        uint32_t mipLevelCount)
+    Loader::DecodedImage::~DecodedImage()
+    {
+        if (pixels)
+        {
+            stbi_image_free(pixels);
+        }
+    }
+
+    bool Loader::DecodeImage(const std::filesystem::path& resourcePath, DecodedImage& image)
     {
-        int width, height, channels, requested_channels = STBI_rgb_alpha;
-        stbi_uc* pixels = stbi_load((resourceDirectory / resourcePath).string().c_str(), &width, &height, &channels,
-                                    requested_channels);
+        AJ_PROFILE_SCOPE("Loader::DecodeImage");
+        image.pixels = stbi_load((resourceDirectory / resourcePath).string().c_str(), &image.width, &image.height,
+                                 &image.channels, STBI_rgb_alpha);
 
-        if (!pixels)
+        if (!image.pixels)
         {
+            AJ_FLIGHT_ERROR("decode failed {}", resourcePath);
             PLOG_ERROR << "Failed to load texture: " << resourcePath;
             PLOG_WARNING << "STBI Error: " << stbi_failure_reason();
-            return nullptr;
+            return false;
         }
+        if (image.channels != STBI_rgb_alpha)
+        {
+            PLOG_DEBUG << "Texture: " << resourcePath << " was converted to 4 channels!";
+        }
+        AJ_FLIGHT_DEBUG("decoded {} {}x{} channels {}", resourcePath, image.width, image.height, image.channels);
+        return true;
+    }
 
-        uint32_t maxMipLevelCount = bit_width(std::max(width, height));
+    Ref<Renderer::Texture>
+    Loader::CreateTextureFromImage(const std::filesystem::path& resourcePath, const Renderer::GpuContext& context,
+                                   const DecodedImage& image, uint32_t mipLevelCount)
+    {
+        AJ_PROFILE_SCOPE("Loader::CreateTextureFromImage");
+        uint32_t maxMipLevelCount = bit_width(std::max(image.width, image.height));
         if (mipLevelCount > maxMipLevelCount)
         {
             PLOG_WARNING << "MipLevelCount is to high for texture: " << resourcePath << " setting to max: "
@@ -201,23 +222,32 @@ namespace Ajiva::Resource
 
         using namespace wgpu;
         auto texture = context.CreateTexture(TextureFormat::RGBA8Unorm,
-                                             {static_cast<uint32_t>(width), static_cast<uint32_t>(height), 1},
+                                             {
+                                                 static_cast<uint32_t>(image.width),
+                                                 static_cast<uint32_t>(image.height), 1
+                                             },
                                              static_cast<const WGPUTextureUsage>(TextureUsage::TextureBinding |
                                                  TextureUsage::CopyDst),
                                              TextureAspect::All,
                                              mipLevelCount,
                                              reinterpret_cast<const char*>(resourcePath.filename().c_str()));
 
-        if (channels != requested_channels)
-        {
-            PLOG_DEBUG << "Texture: " << resourcePath << " was converted to 4 channels!";
-        }
-
-        texture->WriteTextureMips(pixels, width * height * requested_channels, mipLevelCount);
-        stbi_image_free(pixels);
+        AJ_FLIGHT_DEBUG("upload {} {}x{} mips {}", resourcePath, image.width, image.height, mipLevelCount);
+        texture->WriteTextureMips(image.pixels, image.width * image.height * STBI_rgb_alpha, mipLevelCount,
+                                  threadPool.get());
         return texture;
     }
 
+    Ref<Renderer::Texture>
+    Loader::LoadTexture(const std::filesystem::path& resourcePath, const Renderer::GpuContext& context,
+                        uint32_t mipLevelCount)
+    {
+        DecodedImage image;
+        if (!DecodeImage(resourcePath, image))
+            return nullptr;
+        return CreateTextureFromImage(resourcePath, context, image, mipLevelCount);
+    }
+
     Ref<Renderer::Texture>
     Loader::LoadTextureAsync(const std::filesystem::path& resourcePath, const Renderer::GpuContext& context,
                              uint32_t mipLevelCount)
@@ -231,14 +261,37 @@ namespace Ajiva::Resource
                                              1,
                                              reinterpret_cast<const char*>(resourcePath.filename().c_str()));
 
-
-        threadPool->QueueWork([texture, resourcePath, mipLevelCount, context, this]()
-        {
-            auto realTexture = LoadTexture(resourcePath, context, mipLevelCount);
-            realTexture->SetCleanUp(false);
-            texture->SwapBackingTexture(realTexture);
-        });
+        SwapInWhenLoaded(texture, resourcePath, context, mipLevelCount).Detach();
         return texture;
     }
+
+    // the path, context copy and placeholder live in the coroutine frames, the pool and main thread queues only ever
+    // see the resume hops of ResumeOn
+    static_assert(Core::TaskFunction::FitsInline<Core::ResumeCoroutine>);
+
+    Core::Task<Ref<Renderer::Texture>>
+    Loader::LoadTextureTask(std::filesystem::path resourcePath, Renderer::GpuContext context, uint32_t mipLevelCount)
+    {
+        if (threadPool)
+            co_await Core::ResumeOn(*threadPool, Core::WorkPriority::Background);
+        // the pixels live in this frame and are freed as soon as the caller got the texture
+        DecodedImage image;
+        if (!DecodeImage(resourcePath, image))
+            co_return nullptr;
+        co_return CreateTextureFromImage(resourcePath, context, image, mipLevelCount);
+    }
+
+    Core::Task<> Loader::SwapInWhenLoaded(Ref<Renderer::Texture> placeholder, std::filesystem::path resourcePath,
+                                          Renderer::GpuContext context, uint32_t mipLevelCount)
+    {
+        auto texture = co_await LoadTextureTask(std::move(resourcePath), std::move(context), mipLevelCount);
+        if (!texture) co_return;
+        texture->SetCleanUp(false);
+        // the frame reads the backing texture, so the swap itself belongs to the main thread
+        if (mainThread)
+            co_await Core::ResumeOn(*mainThread);
+        AJ_FLIGHT_DEBUG("swap in texture version {}", texture->GetVersion());
+        placeholder->SwapBackingTexture(texture);
+    }
 } // Ajiva
 // Resource
@@ -10,6 +10,8 @@
 #include "stb_image.h"
 #include "tiny_obj_loader.h"
 #include "Core/ThreadPool.h"
+#include "Core/MainThreadDispatcher.h"
+#include "Core/Task.h"
 
 namespace Ajiva::Resource
 {
@@ -18,8 +20,10 @@ namespace Ajiva::Resource
     public:
         Loader() = default;
 
-        explicit Loader(std::filesystem::path resourceDirectory, Ref<Core::IThreadPool> threadPool)
-            : resourceDirectory(std::move(resourceDirectory)), threadPool(std::move(threadPool))
+        explicit Loader(std::filesystem::path resourceDirectory, Ref<Core::IThreadPool> threadPool,
+                        Ref<Core::MainThreadDispatcher> mainThread = nullptr)
+            : resourceDirectory(std::move(resourceDirectory)), threadPool(std::move(threadPool)),
+              mainThread(std::move(mainThread))
         {
         }
 
@@ -38,12 +42,45 @@ namespace Ajiva::Resource
         LoadTexture(const std::filesystem::path& resourcePath, const Renderer::GpuContext& context,
                     uint32_t mipLevelCount = 0);
 
+        // returns a 1x1 placeholder, the real texture is swapped in once decode -> mips/upload finished
+        // the swap runs on the main thread dispatcher if there is one
         Ref<Renderer::Texture>
         LoadTextureAsync(const std::filesystem::path& resourcePath, const Renderer::GpuContext& context,
                          uint32_t mipLevelCount = 0);
 
+        // decode and upload on the pool (background priority), the awaiting coroutine continues on that worker
+        // nullptr if the image could not be decoded
+        Core::Task<Ref<Renderer::Texture>>
+        LoadTextureTask(std::filesystem::path resourcePath, Renderer::GpuContext context,
+                        uint32_t mipLevelCount = 0);
+
+        [[nodiscard]] AJ_INLINE Core::IThreadPool* GetThreadPool() const
+        {
+            return threadPool.get();
+        }
+
     private:
+        struct DecodedImage
+        {
+            int width = 0;
+            int height = 0;
+            int channels = 0;
+            stbi_uc* pixels = nullptr;
+
+            ~DecodedImage();
+        };
+
+        bool DecodeImage(const std::filesystem::path& resourcePath, DecodedImage& image);
+
+        Ref<Renderer::Texture>
+        CreateTextureFromImage(const std::filesystem::path& resourcePath, const Renderer::GpuContext& context,
+                               const DecodedImage& image, uint32_t mipLevelCount);
+
+        Core::Task<> SwapInWhenLoaded(Ref<Renderer::Texture> placeholder, std::filesystem::path resourcePath,
+                                      Renderer::GpuContext context, uint32_t mipLevelCount);
+
         std::filesystem::path resourceDirectory;
         Ref<Core::IThreadPool> threadPool;
+        Ref<Core::MainThreadDispatcher> mainThread;
     };
 } // Ajiva
@@ -6,57 +6,54 @@
 
 #include "defines.h"
 #include "Core/Logger.h"
+#include "Core/ObjectRegistry.h"
 
-#include <vector>
 #include <typeinfo>
-#include <map>
-
-inline std::map<const char*, std::vector<void*>> createdObjects;
 
 // function to be called for every created object that needs to be destroyed
-// stores the object and type in a vector
-inline void AJ_RegisterCreated(void* object, const std::type_info& type)
+// stores the object and type in the object registry, bytes is what the object holds on to (0 if unknown)
+inline void AJ_RegisterCreated([[maybe_unused]] void* object, [[maybe_unused]] const std::type_info& type,
+                               [[maybe_unused]] u64 bytes = 0)
 {
-    PLOG_VERBOSE << "Created: " << type.name() << " at: " << object;
-    createdObjects[type.name()].push_back(object);
+#if AJ_TRACK_OBJECTS
+    Ajiva::Core::ObjectRegistry::Get().Register(object, type, bytes);
+#endif
 }
 
 // function to be called for every destroyed object
-// removes the object from the vector
-inline void AJ_RegisterDestroyed(void* object, const std::type_info& type)
+// removes the object from the registry, complains if it was registered as another type
+inline void AJ_RegisterDestroyed([[maybe_unused]] void* object, [[maybe_unused]] const std::type_info& type)
 {
-    PLOG_VERBOSE << "Destroyed: " << type.name() << " at: " << object;
-    auto& vec = createdObjects[type.name()];
-    auto it = std::find(vec.begin(), vec.end(), object);
-    if (it != vec.end())
-    {
-        vec.erase(it);
-    }
-    else
-    {
-        PLOG_ERROR << "Object not found in createdObjects";
-    }
+#if AJ_TRACK_OBJECTS
+    Ajiva::Core::ObjectRegistry::Get().Unregister(object, &type);
+#endif
 }
 
 // function to be called at the end of the program
 // checks if all objects have been destroyed
 inline void AJ_CheckForLeaks()
 {
-    bool leaks = false;
-    for (auto& pair : createdObjects)
+#if AJ_TRACK_OBJECTS
+    auto& registry = Ajiva::Core::ObjectRegistry::Get();
+    if (!registry.LiveCount())
     {
-        for (auto& object : pair.second)
-        {
-            PLOG_ERROR << "Leaked: " << pair.first << " at: " << object;
-            leaks = true;
-        }
+        PLOG_INFO << "No leaks detected!";
+        return;
     }
-    if (leaks)
+    registry.ForEachLive([](const char* type, const void* object, u64)
     {
-        PLOG_FATAL << "Leaks detected!";
-    }
-    else
+        PLOG_ERROR << "Leaked: " << type << " at: " << object;
+    });
+    for (const auto& stats : registry.Stats())
     {
-        PLOG_INFO << "No leaks detected!";
+        if (stats.Live)
+        {
+            PLOG_ERROR << "Leaked " << stats.Live << " of " << stats.Created << " " << stats.Name << " holding "
+                << stats.Bytes << " bytes";
+        }
     }
+    PLOG_FATAL << "Leaks detected!";
+#else
+    PLOG_INFO << "Object tracking is compiled out, no leak check";
+#endif
 }
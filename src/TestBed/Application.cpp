@@ -10,12 +10,15 @@
 #include "Resource/FilesNames.hpp"
 #include "Renderer/RenderPipelineLayer.h"
 #include "GameOfLife.h"
+#include "Core/Profiler.h"
+#include "Core/FlightRecorder.h"
 
 namespace Ajiva
 {
     Application::~Application() = default;
 
-    Application::Application(ApplicationConfig config) : config(std::move(config))
+    Application::Application(ApplicationConfig config) : config(std::move(config)),
+                                                         scheduler(this->config.FrameSchedulerConfig)
     {
     }
 
@@ -28,16 +31,41 @@ namespace Ajiva
     {
         Core::SetupLogger();
         PLOG_INFO << "Hello, World!";
+        if (!config.FlightRecorderPath.empty())
+            Core::FlightRecorder::Open(config.FlightRecorderPath);
+#if AJ_PROFILING
+        Core::Profiler::SetThreadName("Main");
+#endif
 
-        threadPool = CreateRef<Core::ThreadPool<>>(false);
+        threadPool = CreateRef<Core::ThreadPool>(config.ThreadPoolConfig, false);
         threadPool->Start();
+        mainThread = CreateRef<Core::MainThreadDispatcher>();
 
         eventSystem = CreateRef<Core::EventSystem>();
-        //events.push_back(eventSystem->AddEventListener<Core::FramebufferResize>(AJ_EVENT_CALLBACK_VOID(OnResize)));
-        events.push_back(eventSystem->Add(Core::FramebufferResize, this, &Application::OnResize));
+        // high rate input is merged to one event per frame, a resize storm only rebuilds the swap chain once
+        eventSystem->SetCoalescing(Core::MouseMove, Core::CoalesceMouseMove);
+        eventSystem->SetCoalescing(Core::MouseScroll, Core::CoalesceScroll);
+        eventSystem->SetCoalescing(Core::FramebufferResize, Core::CoalesceLast);
+        if (!config.RecordEventsPath.empty())
+        {
+            eventRecorder = CreateScope<Core::EventRecorder>(config.RecordEventsPath);
+            eventSystem->SetRecorder(eventRecorder.get());
+        }
+        if (!config.ReplayEventsPath.empty())
+        {
+            eventReplayer = CreateScope<Core::EventReplayer>(config.ReplayEventsPath);
+            eventSystem->SetLiveInput(!eventReplayer->IsOpen());
+            // events are fed per frame, so every frame has to simulate the same on every machine: one step each
+            if (eventReplayer->IsOpen())
+                scheduler.SetFixedFrameDelta(scheduler.StepSeconds());
+        }
+        input = CreateRef<Core::InputChannels>();
+        input->Bridge(*eventSystem);
+        resizeSubscription = input->FramebufferResize.Subscribe<&Application::OnResize>(this);
 
         context = CreateRef<Renderer::GpuContext>();
-        loader = CreateRef<Resource::Loader>(config.ResourceDirectory, threadPool);
+        context->GetGpuMemory().SetBudget(config.GpuMemoryBudget);
+        loader = CreateRef<Resource::Loader>(config.ResourceDirectory, threadPool, mainThread);
         graphicsResourceManager = CreateRef<Renderer::GraphicsResourceManager>(context, loader);
         window = CreateRef<Platform::Window>(config.WindowConfig, eventSystem);
 
@@ -49,26 +77,29 @@ namespace Ajiva
         //ImGui first to block camera input
         camera = CreateRef<Renderer::FreeCamera>(eventSystem);
         Renderer::RenderPipelineLayer pipeline(context, loader, graphicsResourceManager,
-                                               [this]() -> glm::mat4x4
+                                               [this](f64 alpha) -> glm::mat4x4
                                                {
                                                    //todo make more compact
-                                                   return camera->viewMatrix;
+                                                   return camera->RenderViewMatrix(alpha);
                                                }, [this]() -> glm::mat4x4
                                                {
                                                    return projection.Build();
-                                               }, [this]() -> glm::vec3
+                                               }, [this](f64 alpha) -> glm::vec3
                                                {
-                                                   return camera->position;
+                                                   return camera->RenderPosition(alpha);
                                                });
         auto pipelineRef = CreateRef<Renderer::RenderPipelineLayer>(pipeline);
         auto golRef = CreateRef<GameOfLife>(context, eventSystem, window, loader, pipelineRef);
-        Renderer::ImGuiLayer imGuiLayer(window, context, eventSystem, pipelineRef, camera);
+        frameStatistics = CreateRef<Core::FrameStatistics>(config.FrameStatisticsConfig);
+        // built in place, the layer subscribes itself to the event system
+        auto imGuiLayer = CreateRef<Renderer::ImGuiLayer>(window, context, eventSystem, pipelineRef, camera,
+                                                          threadPool, frameStatistics);
         camera->Init();
 
         //layers
         layers.push_back(pipelineRef);
         layers.push_back(golRef);
-        layers.push_back(CreateRef<Renderer::ImGuiLayer>(imGuiLayer));
+        layers.push_back(imGuiLayer);
 
         for (const auto& layer : layers)
         {
@@ -82,7 +113,7 @@ namespace Ajiva
 
         //AJ_INFO("Startup Time: %s", clock.Total());
         PLOG_DEBUG << clock.Total().count() / 1000.0f << "s";
-        clock.Reset();
+        scheduler.Start();
         return true;
     }
 
@@ -97,30 +128,78 @@ namespace Ajiva
         using glm::vec4;
         using glm::vec3;
 
-        clock.Update();
-        Core::UpdateInfo frameInfo = {
-            clock.Ticks(),
-            std::chrono::duration_cast<std::chrono::duration<float>>(clock.Delta()).count(),
-            std::chrono::duration_cast<std::chrono::duration<float>>(clock.Total()).count()
-        };
+        AJ_PROFILE_BEGIN_FRAME();
+        scheduler.BeginFrame();
+        frameStatistics->Record(scheduler.FrameClock());
+        FrameUpdate();
+        FrameRender();
+        AJ_PROFILE_END_FRAME();
+        // outside the profiled frame, the limiter only waits
+        scheduler.EndFrame();
+    }
 
-        //update "camera"
-        camera->Update();
+    void Application::FrameUpdate()
+    {
+        AJ_PROFILE_SCOPE("Application::Update");
+        // input from the window callbacks, possibly posted by the dedicated window thread
+        if (eventReplayer && eventReplayer->IsOpen())
+        {
+            eventReplayer->Feed(*eventSystem, eventSystem->DispatchFrame(), window.get());
+            if (eventReplayer->IsFinished() && eventSystem->PendingPosted() == 0)
+            {
+                PLOG_INFO << "Event replay finished";
+                window->RequestClose();
+            }
+        }
+        {
+            AJ_PROFILE_SCOPE("EventSystem::DispatchPosted");
+            eventSystem->DispatchPosted();
+        }
 
-        static std::string lastStats;
-        auto newStats = graphicsResourceManager->Statistics();
-        if (newStats != lastStats)
         {
-            PLOG_INFO << newStats;
-            lastStats = newStats;
+            AJ_PROFILE_SCOPE("GpuContext::PollEvents");
+            // gpu callbacks (queue done, buffer maps) resume their coroutines here
+            context->PollEvents();
+        }
+        {
+            AJ_PROFILE_SCOPE("MainThreadDispatcher::Drain");
+            // continuations from the pool, before any layer looks at textures or buffers
+            mainThread->Drain(std::chrono::microseconds(config.MainThreadBudgetUs));
+        }
+
+        // only rebuilt when a buffer or texture came or went, at most once a second
+        static u64 lastMemoryVersion = INVALID_ID_U64;
+        static Core::Clock::Duration nextStats{};
+        const u64 memoryVersion = context->GetGpuMemory().Version();
+        if (memoryVersion != lastMemoryVersion && clock.Total() >= nextStats
+            && Core::LogEnabled(Core::LogModule::App, plog::info))
+        {
+            nextStats = clock.Total() + std::chrono::seconds(1);
+            lastMemoryVersion = memoryVersion;
+            PLOG_INFO << graphicsResourceManager->Statistics();
         }
 
         //todo seperate render and update thread?
-        for (const auto& layer : layers)
+        // simulation runs at the fixed rate, zero or more steps per frame
+        Core::UpdateInfo updateInfo{};
+        while (scheduler.Step(updateInfo))
         {
-            if (!layer->IsEnabled()) continue;
-            layer->Update(frameInfo);
+            AJ_PROFILE_SCOPE("FixedUpdate");
+            //update "camera"
+            camera->Update();
+            for (const auto& layer : layers)
+            {
+                if (!layer->IsEnabled()) continue;
+                AJ_PROFILE_SCOPE(layer->ProfileName());
+                layer->Update(updateInfo);
+            }
         }
+    }
+
+    void Application::FrameRender()
+    {
+        AJ_PROFILE_SCOPE("Application::Render");
+        const Core::UpdateInfo frameInfo = scheduler.RenderInfo();
 
         wgpu::TextureView nextTexture = swapChain->getCurrentTextureView();
         //std::cout << "nextTexture: " << nextTexture << std::endl;
@@ -149,6 +228,7 @@ namespace Ajiva
         for (const auto& layer : layers)
         {
             if (!layer->IsEnabled()) continue;
+            AJ_PROFILE_SCOPE(layer->ProfileName());
             layer->Render(frameInfo, renderTarget);
         }
 
@@ -158,12 +238,25 @@ namespace Ajiva
             layer->AfterRender(frameInfo, renderTarget);
         }
 
+        // every pass of the frame is submitted, resolve their timestamps
+        context->GetGpuProfiler().EndFrame();
+
         nextTexture.release();
+        AJ_PROFILE_SCOPE("SwapChain::Present");
         swapChain->present();
     }
 
     void Application::Finish()
     {
+        mainThread->DrainAll();
+        eventSystem->SetRecorder(nullptr);
+        eventRecorder.reset();
+        if (!config.FrameTimesPath.empty())
+        {
+            std::filesystem::path path = config.FrameTimesPath;
+            frameStatistics->WriteCsv(path);
+            frameStatistics->WriteHistogramCsv(path.replace_filename(path.stem().string() + "_histogram.csv"));
+        }
         for (const auto& layer : layers)
         {
             if (!layer->IsEnabled()) continue;
@@ -173,9 +266,9 @@ namespace Ajiva
         swapChain->release();
     }
 
-    bool Application::OnResize(Ajiva::Core::EventCode code, void* sender, const Ajiva::Core::EventContext& event)
+    bool Application::OnResize(const Ajiva::Core::FramebufferResizeEvent& event)
     {
-        if (event.framebufferSize.width == 0 || event.framebufferSize.height == 0)
+        if (event.Width == 0 || event.Height == 0)
         {
             PLOG_INFO << "Framebuffer size is 0!";
             return false;
@@ -189,7 +282,7 @@ namespace Ajiva
         /*        uniforms.projectionMatrix = glm::perspective(glm::radians(45.0f), static_cast<float>(event.windowRect.width) /
                                                                                   static_cast<float>(event.windowRect.height),
                                                              0.1f, 100.0f);*/
-        projection.aspect = static_cast<float>(event.windowRect.width) / static_cast<float>(event.windowRect.height);
+        projection.aspect = static_cast<float>(event.Width) / static_cast<float>(event.Height);
         //TODO??        uniformBuffer->UpdateBufferData(&uniforms, sizeof(Ajiva::Renderer::UniformData));
         return false;
     }
@@ -201,7 +294,8 @@ namespace Ajiva
             swapChain->release();
         }
 
-        swapChain = context->CreateSwapChain(window->GetWidth(), window->GetHeight());
+        swapChain = context->CreateSwapChain(window->GetWidth(), window->GetHeight(),
+                                             config.VSync ? wgpu::PresentMode::Fifo : wgpu::PresentMode::Immediate);
     }
 
     void Application::BuildDepthTexture()
@@ -8,11 +8,16 @@
 #include "Renderer/GpuContext.h"
 #include "Resource/Loader.h"
 #include "Core/Clock.h"
+#include "Core/FrameScheduler.h"
+#include "Core/FrameStatistics.h"
 #include "Core/EventSystem.h"
+#include "Core/InputEvents.h"
+#include "Core/EventRecorder.h"
 #include "Renderer/Camera.h"
 #include "Core/Layer.h"
 #include "Renderer/BindGroupBuilder.h"
 #include "Core/ThreadPool.h"
+#include "Core/MainThreadDispatcher.h"
 #include "Renderer/GraphicsResourceManager.h"
 
 namespace Ajiva
@@ -21,6 +26,16 @@ namespace Ajiva
     {
         Ajiva::Platform::WindowConfig WindowConfig;
         std::string ResourceDirectory;
+        Ajiva::Core::ThreadPoolConfig ThreadPoolConfig;
+        u32 MainThreadBudgetUs = 2000; // per frame, for work posted to the main thread dispatcher
+        std::string RecordEventsPath; // capture the input stream to this file
+        std::string ReplayEventsPath; // replay a capture instead of live input, closes once it ran out
+        Ajiva::Core::FrameSchedulerConfig FrameSchedulerConfig;
+        bool VSync = true; // false presents immediately, set FrameSchedulerConfig.TargetFps to pace
+        Ajiva::Core::FrameStatisticsConfig FrameStatisticsConfig;
+        std::string FrameTimesPath; // per frame csv written on exit, plus <name>_histogram.csv
+        std::string FlightRecorderPath; // binary AJ_FLIGHT trace, decode with FlightDecoder
+        Ajiva::Renderer::GpuMemoryBudget GpuMemoryBudget; // bytes per category and total, 0 is unlimited
     };
 
     class AJ_API Application
@@ -38,15 +53,20 @@ namespace Ajiva
 
         ~Application();
 
-        bool OnResize(Ajiva::Core::EventCode code, void* sender, const Ajiva::Core::EventContext& event);
+        bool OnResize(const Ajiva::Core::FramebufferResizeEvent& event);
 
     private:
         ApplicationConfig config = {};
         Ajiva::Core::Clock clock = {};
+        Ajiva::Core::FrameScheduler scheduler;
+        Ref<Core::FrameStatistics> frameStatistics;
         Ref<Ajiva::Platform::Window> window;
         Ref<Ajiva::Renderer::GpuContext> context;
         Ref<Ajiva::Resource::Loader> loader;
         Ref<Core::EventSystem> eventSystem = nullptr;
+        Ref<Core::InputChannels> input = nullptr;
+        Scope<Core::EventRecorder> eventRecorder = nullptr;
+        Scope<Core::EventReplayer> eventReplayer = nullptr;
 
         Ref<Renderer::FreeCamera> camera;
         Renderer::Projection projection = {};
@@ -54,13 +74,19 @@ namespace Ajiva
 
         Ref<Renderer::GraphicsResourceManager> graphicsResourceManager;
         std::vector<Ref<Ajiva::Core::Layer>> layers;
-        std::vector<Ref<Ajiva::Core::IListener>> events;
+        std::vector<Ajiva::Core::EventSubscription> events;
+        Core::EventChannel<Core::FramebufferResizeEvent>::Subscription resizeSubscription;
 
-        Ref<Core::ThreadPool<>> threadPool;
+        Ref<Core::ThreadPool> threadPool;
+        Ref<Core::MainThreadDispatcher> mainThread;
 
     private:
         void BuildSwapChain();
 
         void BuildDepthTexture();
+
+        void FrameUpdate();
+
+        void FrameRender();
     };
 }
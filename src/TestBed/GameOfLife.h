@@ -13,6 +13,7 @@
 #include "Core/Layer.h"
 #include "Renderer/BindGroupBuilder.h"
 #include "Core/ThreadPool.h"
+#include "Core/Parallel.h"
 #include "Renderer/GraphicsResourceManager.h"
 #include "Resource/FilesNames.hpp"
 #include "imgui.h"
@@ -58,21 +59,23 @@ namespace Ajiva {
         //Ref<Renderer::Texture> texture;
 
 
-        std::uniform_real_distribution<f32> dist;
-        std::mt19937 engine;
+        // one generator per row chunk, seeded from the chunk start
+        void FillRandom() {
+            const u32 seed = std::random_device{}();
+            Core::ParallelFor(loader->GetThreadPool(), 0, dimension, 16, [this, seed](u64 begin, u64 end) {
+                std::uniform_real_distribution<f32> dist(0.0, 1.0);
+                std::mt19937 engine(seed + static_cast<u32>(begin));
+                for (u64 i = begin * dimension; i < end * dimension; ++i) {
+                    data[i] = dist(engine);
+                }
+            });
+        }
+
         bool Attached() override {
             using namespace wgpu;
             Layer::Attached();
 
-            //create random distribution
-            dist = std::uniform_real_distribution<f32>(0.0, 1.0);
-            engine = std::mt19937(std::random_device{}());
-
-            for (int i = 0; i < dimension; ++i) {
-                for (int j = 0; j < dimension; ++j) {
-                    data[i * dimension + j] = dist(engine);
-                }
-            }
+            FillRandom();
 
             {
                 texture = context->CreateTexture(
@@ -168,11 +171,7 @@ namespace Ajiva {
             }
 
             if (ImGui::Button("New Data")) {
-                for (int i = 0; i < dimension; ++i) {
-                    for (int j = 0; j < dimension; ++j) {
-                        data[i * dimension + j] = dist(engine);
-                    }
-                }
+                FillRandom();
 
                 context->queue->writeBuffer(*inputBuffer, 0, data.data(), data.size());
             }
@@ -182,6 +181,7 @@ namespace Ajiva {
 
                 auto pass = encoder.beginComputePass(WGPUComputePassDescriptor{
                         .label = "GOL Compute Pass",
+                        .timestampWrites = context->GetGpuProfiler().ComputePass("GOL Compute Pass"),
                 });
                 pass.setPipeline(*pipeline);
                 pass.setBindGroup(0, bindGroup, 0, nullptr);
@@ -12,18 +12,39 @@
 #include "defines.h"
 #include "Core/Logger.h"
 #include "Core/Clock.h"
+#include "Core/FlightRecorder.h"
 
 #include "Resource/Loader.h"
 #include "Application.h"
 #include "Resource/ResourceManager.h"
 
+#include <cstring>
 
-int main()
+
+int main(int argc, char* argv[])
 {
     using namespace Ajiva;
     using namespace Ajiva::Renderer;
     using namespace Ajiva::Resource;
 
+    // --record <file> captures the input events, --replay <file> plays them back instead of live input
+    // --frame-times <file> writes the per frame csv on exit, --flight-recorder <file> keeps a binary trace
+    std::string recordEvents;
+    std::string replayEvents;
+    std::string frameTimes;
+    std::string flightRecorder;
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        if (!std::strcmp(argv[i], "--record"))
+            recordEvents = argv[++i];
+        else if (!std::strcmp(argv[i], "--replay"))
+            replayEvents = argv[++i];
+        else if (!std::strcmp(argv[i], "--frame-times"))
+            frameTimes = argv[++i];
+        else if (!std::strcmp(argv[i], "--flight-recorder"))
+            flightRecorder = argv[++i];
+    }
+
     Ajiva::Platform::PlatformSystem::Init();
     {
         ApplicationConfig config = {
@@ -33,7 +54,15 @@ int main()
                 .DedicatedThread = false,
                 .Name = "Ajiva Engine"
             },
-            .ResourceDirectory = RESOURCE_DIR
+            .ResourceDirectory = RESOURCE_DIR,
+            .ThreadPoolConfig = {
+                .ReservedCores = 1,
+                .Name = "Ajiva Worker"
+            },
+            .RecordEventsPath = recordEvents,
+            .ReplayEventsPath = replayEvents,
+            .FrameTimesPath = frameTimes,
+            .FlightRecorderPath = flightRecorder
         };
         Application app(config);
         if (!app.Init())
@@ -50,10 +79,12 @@ int main()
         app.Finish();
     }
 
+    // the worker threads are gone with the application
+    Ajiva::Core::FlightRecorder::Close();
     Ajiva::Platform::PlatformSystem::Shutdown();
 
     AJ_CheckForLeaks();
-
+    Ajiva::Core::ShutdownLogger();
 
     return 0;
 }
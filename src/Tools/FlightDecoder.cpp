@@ -0,0 +1,199 @@
+//
+// Created by XuriAjiva on 17.10.2026.
+//
+
+// Turns a flight recording back into plog style text:
+//   FlightDecoder <recording> [--tail <records>]
+
+#include "defines.h"
+#include "Core/FlightRecorder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace Ajiva::Core;
+
+static std::string DecodeArgument(const u8*& in, const u8* end)
+{
+    const auto tag = static_cast<FlightArg>(*in++);
+    const auto read = [&in, end](auto& value)
+    {
+        if (end - in < static_cast<std::ptrdiff_t>(sizeof(value))) return false;
+        std::memcpy(&value, in, sizeof(value));
+        in += sizeof(value);
+        return true;
+    };
+    std::ostringstream ss;
+    switch (tag)
+    {
+    case FlightArg::Int:
+        {
+            i64 value = 0;
+            if (read(value)) ss << value;
+            break;
+        }
+    case FlightArg::UInt:
+        {
+            u64 value = 0;
+            if (read(value)) ss << value;
+            break;
+        }
+    case FlightArg::Float:
+        {
+            f64 value = 0;
+            if (read(value)) ss << value;
+            break;
+        }
+    case FlightArg::Bool:
+        {
+            u8 value = 0;
+            if (read(value)) ss << (value ? "true" : "false");
+            break;
+        }
+    case FlightArg::Char:
+        {
+            u8 value = 0;
+            if (read(value)) ss << static_cast<char>(value);
+            break;
+        }
+    case FlightArg::Pointer:
+        {
+            u64 value = 0;
+            if (read(value)) ss << "0x" << std::hex << value;
+            break;
+        }
+    case FlightArg::String:
+        {
+            u8 length = 0;
+            if (read(length))
+            {
+                const u64 count = std::min<u64>(length, end - in);
+                ss.write(reinterpret_cast<const char*>(in), static_cast<std::streamsize>(count));
+                in += count;
+            }
+            break;
+        }
+    default:
+        in = end;
+        return "<?>";
+    }
+    return ss.str();
+}
+
+static std::string FormatMessage(const char* format, const FlightSlot& slot)
+{
+    const u8* in = slot.Data;
+    const u8* end = slot.Data + std::min<u64>(slot.Size, sizeof(slot.Data));
+    std::string message;
+    for (const char* c = format; *c; ++c)
+    {
+        if (c[0] == '{' && c[1] == '}' && in < end)
+        {
+            message += DecodeArgument(in, end);
+            ++c;
+        }
+        else
+        {
+            message += *c;
+        }
+    }
+    // more arguments than placeholders
+    while (in < end)
+        message += " " + DecodeArgument(in, end);
+    if (slot.Flags & FlightSlotTruncated)
+        message += " [truncated]";
+    return message;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::cerr << "usage: FlightDecoder <recording> [--tail <records>]\n";
+        return 1;
+    }
+    u64 tail = 0;
+    for (int i = 2; i + 1 < argc; ++i)
+    {
+        if (!std::strcmp(argv[i], "--tail"))
+            tail = std::strtoull(argv[++i], nullptr, 10);
+    }
+
+    std::ifstream file(argv[1], std::ios::binary);
+    if (!file)
+    {
+        std::cerr << "could not open " << argv[1] << "\n";
+        return 1;
+    }
+    const std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    FlightHeader header;
+    if (bytes.size() < sizeof(header))
+    {
+        std::cerr << argv[1] << " is not a flight recording\n";
+        return 1;
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    const u64 expected = sizeof(FlightHeader) + u64(header.SiteCapacity) * sizeof(FlightSite) +
+        u64(header.SlotCount) * sizeof(FlightSlot);
+    if (std::memcmp(header.Magic, "AJFR", 4) != 0 || header.Version != 1 || header.SlotSize != sizeof(FlightSlot) ||
+        header.SiteSize != sizeof(FlightSite) || bytes.size() < expected)
+    {
+        std::cerr << argv[1] << " is not a flight recording of this version\n";
+        return 1;
+    }
+
+    const auto* sites = reinterpret_cast<const FlightSite*>(bytes.data() + sizeof(FlightHeader));
+    const auto* slots = reinterpret_cast<const FlightSlot*>(sites + header.SiteCapacity);
+    const u32 siteCount = std::min(header.SiteCount, header.SiteCapacity);
+
+    // a slot is valid if it holds the sequence its position stands for, anything else was cut by a crash
+    std::vector<const FlightSlot*> records;
+    for (u64 i = 0; i < header.SlotCount; ++i)
+    {
+        const FlightSlot& slot = slots[i];
+        if (slot.Sequence && (slot.Sequence - 1) % header.SlotCount == i)
+            records.push_back(&slot);
+    }
+    std::sort(records.begin(), records.end(), [](const FlightSlot* a, const FlightSlot* b)
+    {
+        return a->Sequence < b->Sequence;
+    });
+    const u64 inRing = std::min<u64>(header.Cursor, header.SlotCount);
+    std::cerr << header.Cursor << " records written, " << records.size() << " of the last " << inRing
+        << " decoded\n";
+    if (tail && records.size() > tail)
+        records.erase(records.begin(), records.end() - static_cast<std::ptrdiff_t>(tail));
+
+    for (const FlightSlot* slot : records)
+    {
+        const u64 ns = header.StartNs + slot->TimeNs;
+        const time_t seconds = static_cast<time_t>(ns / 1000000000ull);
+        tm t{};
+        plog::util::localtime_s(&t, &seconds);
+
+        std::cout << t.tm_year + 1900 << "-" << std::setfill('0') << std::setw(2) << t.tm_mon + 1 << "-"
+            << std::setw(2) << t.tm_mday << " " << std::setw(2) << t.tm_hour << ":" << std::setw(2) << t.tm_min << ":"
+            << std::setw(2) << t.tm_sec << "." << std::setw(3) << ns / 1000000ull % 1000 << " ";
+
+        if (slot->Site >= siteCount)
+        {
+            std::cout << "?     [" << slot->Tid << "] unknown site " << slot->Site << "\n";
+            continue;
+        }
+        const FlightSite& site = sites[slot->Site];
+        std::cout << std::setfill(' ') << std::setw(5) << std::left
+            << plog::severityToString(static_cast<plog::Severity>(site.Severity)) << std::right << " ";
+        std::cout << "[" << slot->Tid << "] ";
+        std::cout << "[" << site.File << ":" << site.Line << "] ";
+        std::cout << "(" << site.Func << "): ";
+        std::cout << FormatMessage(site.Format, *slot) << "\n";
+    }
+    return 0;
+}